@@ -0,0 +1,98 @@
+// geo_kernels_bench.cpp
+// shapes tested per second by each geometry kernel set, scalar vs simd
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "shapes/geo_kernels.h"
+#include "shapes/geo_kernels_internal.h"
+
+namespace {
+
+const size_t kShapes = 1 << 16;
+const int kRuns = 200;
+
+// random shapes of one type laid out as the shape columns gather them
+struct Columns {
+  std::vector<double> a, b, c, d;
+  std::vector<QPointF> points;
+};
+
+Columns makeColumns() {
+  std::mt19937 rng(11);
+  std::uniform_real_distribution<double> coord(0, 2000), radius(1, 200);
+  Columns cols;
+  for (size_t i = 0; i < kShapes; i++) {
+    cols.a.push_back(coord(rng));
+    cols.b.push_back(coord(rng));
+    cols.c.push_back(radius(rng));
+    cols.d.push_back(radius(rng));
+    cols.points.emplace_back(coord(rng), coord(rng));
+  }
+  return cols;
+}
+
+// best of kRuns, in million shapes per second
+template <class Fn>
+double rate(Fn&& fn) {
+  double best = 1e30;
+  for (int r = 0; r < kRuns; r++) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    std::chrono::duration<double> took =
+        std::chrono::steady_clock::now() - start;
+    if (took.count() < best) best = took.count();
+  }
+  return kShapes / best / 1e6;
+}
+
+// one line per kernel, mismatches against the scalar answers are counted
+void run(const char* name, const GeoKernels::Kernels& k,
+         const GeoKernels::Kernels& ref, const Columns& cols) {
+  const double *a = cols.a.data(), *b = cols.b.data();
+  const double *c = cols.c.data(), *d = cols.d.data();
+  std::vector<uint8_t> hits(kShapes), refHits(kShapes);
+  std::vector<double> dist(kShapes), refDist(kShapes);
+  double x = 1000, y = 1000;
+  size_t wrong = 0;
+
+  double extent = rate([&]() { k.extent(cols.points.data(), kShapes); });
+  double segments = rate([&]() {
+    k.segmentDistSq({a, b, c, d, kShapes}, x, y, dist.data());
+  });
+  ref.segmentDistSq({a, b, c, d, kShapes}, x, y, refDist.data());
+  wrong += dist != refDist;
+  double ellipses =
+      rate([&]() { k.ellipseHits({a, b, c, d, kShapes}, x, y, hits.data()); });
+  ref.ellipseHits({a, b, c, d, kShapes}, x, y, refHits.data());
+  wrong += hits != refHits;
+  double hexagons = rate([&]() {
+    k.hexagonHits({a, b, c, d, kShapes, false}, x, y, hits.data());
+  });
+  ref.hexagonHits({a, b, c, d, kShapes, false}, x, y, refHits.data());
+  wrong += hits != refHits;
+
+  printf("%-7s %9.1f %9.1f %9.1f %9.1f  %s\n", name, extent, segments,
+         ellipses, hexagons, wrong ? "MISMATCH" : "exact");
+}
+
+}  // namespace
+
+int main() {
+  Columns cols = makeColumns();
+  const GeoKernels::Kernels& scalar = GeoKernels::scalarKernels();
+  printf("%zu shapes, best of %d runs, million shapes per second\n", kShapes,
+         kRuns);
+  printf("%-7s %9s %9s %9s %9s\n", "", "extent", "segments", "ellipses",
+         "hexagons");
+  run("scalar", scalar, scalar, cols);
+#ifdef GEO_X86_KERNELS
+  __builtin_cpu_init();
+  run("sse2", GeoKernels::sse2Kernels(), scalar, cols);
+  if (__builtin_cpu_supports("avx2"))
+    run("avx2", GeoKernels::avx2Kernels(), scalar, cols);
+#endif
+  return 0;
+}
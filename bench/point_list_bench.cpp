@@ -0,0 +1,95 @@
+// point_list_bench.cpp
+// throughput of svg points attribute decoding, old stream parse vs simd
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "parse/char_classify.h"
+#include "parse/svg_parser_internal.h"
+
+namespace {
+
+const int kRuns = 10;
+
+// freehand strokes as this app writes them, two decimals per coordinate
+std::string makePoints(size_t count) {
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> coord(0, 2000);
+  std::string text;
+  char buf[64];
+  for (size_t i = 0; i < count; i++) {
+    snprintf(buf, sizeof(buf), "%.2f,%.2f ", coord(rng), coord(rng));
+    text += buf;
+  }
+  return text;
+}
+
+// the istringstream and stod loop the parser used before
+size_t streamParse(const std::string& text, std::vector<QPointF>& out) {
+  std::istringstream iss(text);
+  std::string pair;
+  while (iss >> pair) {
+    size_t comma = pair.find(',');
+    if (comma != std::string::npos)
+      out.emplace_back(std::stod(pair.substr(0, comma)),
+                       std::stod(pair.substr(comma + 1)));
+  }
+  return out.size();
+}
+
+// best of kRuns, in megabytes per second
+template <class Fn>
+double throughput(size_t bytes, Fn&& fn) {
+  double best = 1e30;
+  for (int r = 0; r < kRuns; r++) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    std::chrono::duration<double> took =
+        std::chrono::steady_clock::now() - start;
+    if (took.count() < best) best = took.count();
+  }
+  return bytes / best / 1e6;
+}
+
+// classify every 64 byte block, the part the simd kernels replace
+uint64_t classifyAll(const std::string& text, SvgParser::ClassifyFn fn) {
+  uint64_t acc = 0;
+  for (size_t i = 0; i + 64 <= text.size(); i += 64) {
+    SvgParser::CharMasks m = fn(text.data() + i);
+    acc += m.separator ^ m.digit;
+  }
+  return acc;
+}
+
+}  // namespace
+
+int main() {
+  std::string text = makePoints(2000000);
+  size_t bytes = text.size();
+  size_t sink = 0;
+  printf("points attribute of %zu bytes, best of %d runs\n", bytes, kRuns);
+
+  double stream = throughput(bytes, [&]() {
+    std::vector<QPointF> out;
+    sink += streamParse(text, out);
+  });
+  double simd = throughput(bytes, [&]() {
+    PointBuffer out;
+    sink += SvgParser::parsePointList(text, out);
+  });
+  printf("decode    stream %8.1f MB/s  simd %8.1f MB/s  %.1fx\n", stream,
+         simd, simd / stream);
+
+  double scalar = throughput(bytes, [&]() {
+    sink += classifyAll(text, SvgParser::classifyScalar);
+  });
+  SvgParser::ClassifyFn best = SvgParser::selectClassifier();
+  double vector = throughput(bytes, [&]() { sink += classifyAll(text, best); });
+  printf("classify  scalar %8.1f MB/s  simd %8.1f MB/s  %.1fx\n", scalar,
+         vector, vector / scalar);
+  return sink == 0;
+}
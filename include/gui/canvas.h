@@ -5,18 +5,30 @@ main drawing area widget, handles mouse events and drawing shapes
 also manages the list of shapes, the current selection, and the undo/redo stacks
 */
 #pragma once
+#include <QImage>
 #include <QKeyEvent>
 #include <QMouseEvent>
 #include <QWidget>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
+#include "gui/document_journal.h"
+#include "gui/shape_columns.h"
+#include "gui/shape_index.h"
 #include "gui/shape_mode.h"
+#include "gui/shape_store.h"
 #include "shapes/graphics_object.h"
 #include "tools/canvas_state.h"
 #include "tools/command.h"
 
 class QLineEdit;  // forward declaration for text
+class QThread;
+class SvgLoadWorker;
+class SvgSaveWorker;
+class SaveSnapshot;
+class QPainter;
+class QRegion;
 
 class Canvas : public QWidget {
   Q_OBJECT
@@ -29,10 +41,57 @@ class Canvas : public QWidget {
   };
 
  private:
-  // list of shapes currently in the document.
+  // shapes currently in the document, back to front.
   // shared pointers since tools may be referenced by multiple states/commands
   // and we want automatic memory management
-  std::vector<std::shared_ptr<GraphicsObject>> shapes;
+  ShapeStore shapes;
+
+  // spatial index over shapes for hit testing, kept in sync by the
+  // add/remove/setShapes/shapeChanged helpers below
+  ShapeIndex shapeIndex;
+
+  // contiguous copy of bounds, types and styles for whole document scans,
+  // kept in sync by the same helpers
+  ShapeColumns columns;
+
+  // crash recovery log fed by the same helpers, written per history step
+  DocumentJournal journal;
+
+  // last area the preview shape was painted in, repainted when it changes
+  QRectF previewBounds;
+
+  // area a shape paints, taken from the index when the shape is indexed
+  QRectF paintBoundsOf(const std::shared_ptr<GraphicsObject>& shape) const;
+
+  // widget rect to repaint for paint bounds, with room for selection handles
+  QRect repaintRect(const QRectF& paintBounds) const;
+
+ public:
+  // per frame counters filled by the culling stage of paintEvent
+  struct PaintStats {
+    size_t drawn = 0;   // shapes drawn in the last paint event
+    size_t culled = 0;  // shapes skipped because they were not exposed
+  };
+
+ private:
+  PaintStats paintStats;
+
+  // keep only shapes whose paint bounds meet the exposed region
+  void cullShapes(const QRegion& exposed,
+                  std::vector<std::shared_ptr<GraphicsObject>>& out);
+
+  // raster of the shapes that stay still during a drag, split around the
+  // dragged shape so compositing keeps the z order
+  struct StaticLayer {
+    QImage below;  // opaque, includes the white background
+    QImage above;  // transparent, null when nothing is above the active shape
+    std::shared_ptr<GraphicsObject> active;
+    bool valid = false;
+  };
+  StaticLayer staticLayer;
+
+  QSize layerPixelSize() const;
+  bool paintStaticLayer(QPainter& painter);
 
   // temp shapes and currently selected shapes
   std::shared_ptr<GraphicsObject> previewShape = nullptr;
@@ -58,8 +117,18 @@ class Canvas : public QWidget {
   bool dirty = false;  // dirty flag for unsaved changes
 
   // ids to track saved state and current state for undo/redo
+  // the document is modified when the current id differs from the saved one
   int currentStateId = 0;
   int nextStateId = 1;
+  int savedStateId = 0;
+
+  // bumped by every shape list or shape mutation, compared against the value
+  // at the last history step to catch edits no command recorded yet
+  uint64_t documentRevision = 0;
+  uint64_t stateRevision = 0;
+
+  // move to a history state id and remember the revision it was reached at
+  void enterState(int stateId);
 
   bool historyReplayInProgress = false;
 
@@ -68,11 +137,6 @@ class Canvas : public QWidget {
   QLineEdit* textEditor = nullptr;  // in-place editor widget
   std::string textBeforeEditing;    // original text before edit
 
-  QString savedXml;  // cached xml representations for change tracking
-
-  QString computeDocumentXml()
-      const;  // compute current document XML for change tracking
-
   // Draft shape used while editing text (separate from previewShape).
   std::shared_ptr<GraphicsObject> textDraftShape = nullptr;
 
@@ -80,6 +144,36 @@ class Canvas : public QWidget {
 
   void syncModifiedState();
 
+  // background open in progress, all null when no load is running
+  // loadContext receives the worker signals, deleting it drops any still
+  // queued batch of a cancelled load
+  QThread* loadThread = nullptr;
+  SvgLoadWorker* loadWorker = nullptr;
+  QObject* loadContext = nullptr;
+  QString loadingPath;
+  // set once loaded shapes replaced the document that was open
+  bool loadReplacedDocument = false;
+
+  void startLoad(const QString& path, double simplifyTolerance);
+  void replaceDocumentForLoad();
+  void appendShapes(std::vector<std::shared_ptr<GraphicsObject>> batch);
+  void finishLoad(bool ok, bool cancelled, size_t removedPoints);
+  void stopLoadThread();
+
+  // background save in progress, all null when no save is running
+  // the snapshot was taken at saveStateId and saveRevision
+  QThread* saveThread = nullptr;
+  SvgSaveWorker* saveWorker = nullptr;
+  QObject* saveContext = nullptr;
+  int saveStateId = 0;
+  uint64_t saveRevision = 0;
+
+  // the shapes the running save writes, shared with its worker
+  std::shared_ptr<SaveSnapshot> saveSnapshot;
+
+  void finishSave();
+  bool joinSaveThread();
+
  protected:
   // handling painting and input events
   void paintEvent(QPaintEvent* event) override;
@@ -97,12 +191,53 @@ class Canvas : public QWidget {
   void setState(std::unique_ptr<CanvasState> newState);
 
   // Accessors for shapes and selection
-  std::vector<std::shared_ptr<GraphicsObject>>& getShapes();
+  const ShapeStore& getShapes() const;
   std::shared_ptr<GraphicsObject>& getSelectedShape();
   std::shared_ptr<GraphicsObject>& getPreviewShape();
   void setSelectedShape(std::shared_ptr<GraphicsObject> shape);
   void setPreviewShape(std::shared_ptr<GraphicsObject> shape);
 
+  // document mutations, these keep the spatial index in sync
+  // removeShape returns the z key the shape had so undo can put it back
+  // exactly there with insertShape
+  void addShape(std::shared_ptr<GraphicsObject> shape);
+  ShapeStore::ZKey removeShape(const std::shared_ptr<GraphicsObject>& shape);
+  void insertShape(std::shared_ptr<GraphicsObject> shape, ShapeStore::ZKey z);
+  void setShapes(ShapeStore newShapes);
+
+  // must be called after a shape in the document moved, resized or restyled
+  // repaints the area the shape covered before and after the change
+  void shapeChanged(const std::shared_ptr<GraphicsObject>& shape);
+
+  // must be called before a shape in the document is edited in place, a
+  // running save keeps writing the shape as it was
+  void aboutToChange(const std::shared_ptr<GraphicsObject>& shape);
+
+  // repaint only the area a shape currently covers
+  void invalidateShape(const std::shared_ptr<GraphicsObject>& shape);
+
+  // must be called after the preview shape geometry changed
+  void previewChanged();
+
+  // cache every shape except the active one (null while creating) for the
+  // rest of a drag, any document change or state switch drops the cache
+  void beginStaticLayer(const std::shared_ptr<GraphicsObject>& active);
+  void dropStaticLayer();
+  bool hasStaticLayer() const;
+
+  // drawn and culled shape counts of the most recent paint event
+  const PaintStats& lastPaintStats() const;
+
+  // shapes whose box meets, or with contained set lies inside, the area,
+  // back to front
+  void shapesInRect(const QRectF& area, bool contained,
+                    std::vector<std::shared_ptr<GraphicsObject>>& out) const;
+  ShapeColumns::Stats documentStats() const;
+
+  // topmost shape under a point, optionally restricted by a filter
+  std::shared_ptr<GraphicsObject> shapeAt(
+      QPointF p, const ShapeColumns::Filter& filter = nullptr) const;
+
   // Mode getters/setters
   ShapeMode getMode() const;
   void setMode(ShapeMode mode);
@@ -121,7 +256,20 @@ class Canvas : public QWidget {
   // push to the stacks
   void pushCommand(std::unique_ptr<Command> cmd);
 
+  // a gesture ended without a history step because its edits cancelled
+  // out, so they stop counting as unsaved changes
+  void settleEdits();
+
   bool isModified() const;
+  bool isLoading() const;
+  bool isSaving() const;
+
+  // block until a running save committed or failed
+  void waitForSave();
+
+  // offer to recover a journal left by a crashed session, then start
+  // journaling, called once the window is shown
+  void startJournal();
   QString getFilePath() const;
   bool isHistoryReplayInProgress() const;
 
@@ -130,6 +278,13 @@ class Canvas : public QWidget {
   void selectionChanged();
   void modifiedChanged();
 
+  // emitted when freehand simplification dropped points, on release or open
+  void strokeSimplified(size_t removedPoints);
+
+  // background open progress, loading is false once it finished or stopped
+  void loadStateChanged(bool loading);
+  void loadProgress(int percent);
+
  public slots:
   void copySelected();
   void cutSelected();
@@ -141,5 +296,6 @@ class Canvas : public QWidget {
   void save();
   void saveAs();
   void openFile();
+  void cancelLoad();
   void newFile();
 };
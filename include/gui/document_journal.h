@@ -0,0 +1,105 @@
+// document_journal.h
+// append only log of document edits for crash recovery
+#pragma once
+#include <QLockFile>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gui/shape_store.h"
+#include "shapes/graphics_object.h"
+#include "shapes/svg_writer.h"
+
+/*
+one journal per running session, named uniquely and held with a lock file
+so other instances leave it alone, a header line naming the saved svg it
+starts from, then
+  F <size> <hash>  fingerprint of that file when the journal started
+  K <z> <z> ...    key of each shape of the file in document order, left
+                   out when they are 1 to n
+followed by one line per record:
+  A <z> <svg>  insert a shape at z key z
+  R <z>        remove the shape at z key z
+  P <z> <svg>  replace the shape at z key z after an edit
+  C            remove every shape
+  S <z> ...    a save snapshot of the shapes with these keys was taken
+records are buffered between history steps and written by commit, so each
+undo, redo or new command costs the size of the edit, not of the document
+shapes of the file the journal starts from get the keys 1 to n in order
+unless a K line follows the header, after a save the keys of the live
+document have gaps where shapes were removed and later records use them
+a save replaces the file before the journal restarts from it, when the
+file no longer matches F the save committed and replay starts at the last
+S instead of applying the records before it a second time
+*/
+class DocumentJournal {
+ public:
+  using ShapeVec = std::vector<std::shared_ptr<GraphicsObject>>;
+
+ private:
+  // structural edits in order with the z key they apply to
+  struct Pending {
+    char type;
+    std::shared_ptr<GraphicsObject> shape;
+    ShapeStore::ZKey z;
+  };
+
+  std::string filePath;  // empty while no journal is active
+  std::unique_ptr<QLockFile> lock;  // held for as long as filePath is used
+  std::ofstream file;
+  std::vector<Pending> pending;
+  ShapeVec changed;  // shapes edited since the last commit
+  std::streamoff snapshotOffset = -1;
+  std::vector<ShapeStore::ZKey> snapshotKeys;  // of the shapes saved
+  SvgWriter scratch;  // reused for the markup of every shape record
+
+  void writeHeader(const std::string& basePath,
+                   const std::vector<ShapeStore::ZKey>& keys = {});
+  void appendShape(std::string& line, const GraphicsObject& shape);
+  bool acquire(const std::string& journalFile);
+  // "<size> <hash>" of the bytes of a file, empty when it cannot be read
+  static std::string fingerprint(const std::string& path);
+  // " <z> <z> ..." of keys, empty when they count up from 1
+  static std::string keyList(const std::vector<ShapeStore::ZKey>& keys);
+  static std::string journalDir();
+  static std::string newJournalFile();
+
+ public:
+  // start an empty journal on top of basePath, empty for a new document,
+  // and remove the journal of the previous document
+  void start(const std::string& basePath);
+  // keep appending to a journal left by a crashed session, false when
+  // another session took it first
+  bool resume(const std::string& journalFile);
+  // remove the journal file, used on a clean close
+  void discard();
+
+  // mutation hooks of the canvas, nothing is written until commit
+  void shapeAdded(const std::shared_ptr<GraphicsObject>& shape,
+                  ShapeStore::ZKey z);
+  void shapeRemoved(ShapeStore::ZKey z);
+  void shapesCleared();
+  void shapeChanged(const std::shared_ptr<GraphicsObject>& shape);
+
+  // write the records of one history step, shapes is the current document
+  void commit(const ShapeStore& shapes);
+
+  // a save took a snapshot of shapes, once it committed to path the
+  // journal restarts from that file keeping only the records after it
+  void markSnapshot(const ShapeStore& shapes);
+  void snapshotSaved(const std::string& path);
+
+  // journal files of sessions that did not close cleanly, newest first
+  // a journal counts once its lock is stale, journals without a single
+  // record are removed on the way
+  static std::vector<std::string> leftovers();
+  // rebuild the document of a journal file, false if it is unreadable
+  static bool replay(const std::string& journalFile, std::string& basePath,
+                     ShapeStore& shapes);
+  // remove a leftover journal the user did not want back
+  static void remove(const std::string& journalFile);
+
+  // file of the running journal, empty while none is active
+  const std::string& path() const { return filePath; }
+};
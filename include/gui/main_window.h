@@ -7,6 +7,8 @@
 class Canvas;           // in canvas.h
 class PropertiesPanel;  // in properties_panel.h
 class ToolBar;          // in tool_bar.h
+class QProgressBar;
+class QPushButton;
 
 class MainWindow : public QMainWindow {
   Q_OBJECT
@@ -17,11 +19,19 @@ class MainWindow : public QMainWindow {
   PropertiesPanel* panel;
   ToolBar* toolBar;
 
+  // status bar widgets shown while a file opens in the background
+  QProgressBar* loadBar;
+  QPushButton* cancelLoadButton;
+
   void createMenus();  // internal setup helper for menus
 
  private slots:              // internal event handlers
   void closeFile();          // event handler for close action
   void updateWindowTitle();  // updating titlebar with filename and status
+  void editSimplifyTolerance();  // edit freehand simplification tolerance
+  void showSimplified(size_t removedPoints);  // status bar report
+  void showLoadState(bool loading);  // toggle open progress widgets
+  void showDocumentStats();          // shape counts and drawing size
 
  public:
   explicit MainWindow(QWidget* parent = nullptr);
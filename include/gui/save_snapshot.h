@@ -0,0 +1,48 @@
+// save_snapshot.h
+// document shapes shared with a background save without copying them
+#pragma once
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "shapes/graphics_object.h"
+
+// the save writes the live shapes, a shape the canvas is about to edit
+// before the save reached it is swapped for a copy first
+// a shape is written under the lock of its block, so the canvas never
+// swaps or edits a shape while a save thread reads it
+class SaveSnapshot {
+ public:
+  explicit SaveSnapshot(std::vector<std::shared_ptr<GraphicsObject>> shapes);
+
+  size_t size() const { return shapes.size(); }
+
+  // save threads, fn gets the shapes of [first, last) in order
+  template <class Fn>
+  void write(size_t first, size_t last, Fn&& fn) {
+    for (size_t i = first; i < last; i++) {
+      std::lock_guard<std::mutex> hold(lockOf(i));
+      fn(*shapes[i]);
+      written[i] = 1;
+    }
+  }
+
+  // gui thread, before shape is edited in place
+  void aboutToChange(const GraphicsObject* shape);
+
+ private:
+  static constexpr size_t kBlock = 256;
+  static constexpr size_t kLocks = 64;
+
+  // slots are only swapped by the gui thread, written only by save threads
+  std::vector<std::shared_ptr<GraphicsObject>> shapes;
+  std::vector<uint8_t> written;
+  std::array<std::mutex, kLocks> locks;
+  // slot of each shape, built at the first edit during the save
+  std::unordered_map<const GraphicsObject*, size_t> slotOf;
+
+  std::mutex& lockOf(size_t slot) { return locks[slot / kBlock % kLocks]; }
+};
@@ -0,0 +1,80 @@
+// shape_columns.h
+// structure of arrays copy of shape bounds, types and styles for bulk scans
+#pragma once
+#include <QPointF>
+#include <QRectF>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "gui/shape_store.h"
+#include "shapes/graphics_object.h"
+#include "shapes/shape_type.h"
+
+// one row per document shape with every field in its own contiguous column,
+// so a scan over the whole document reads only the fields it tests instead
+// of chasing a pointer per shape
+// rows are unordered, a removal moves the last row into the hole
+class ShapeColumns {
+ public:
+  using ShapePtr = std::shared_ptr<GraphicsObject>;
+  using Filter = std::function<bool(const GraphicsObject&)>;
+
+  // totals of a whole document scan
+  struct Stats {
+    size_t shapes = 0;
+    std::array<size_t, static_cast<size_t>(ShapeType::Count)> byType{};
+    size_t filled = 0;   // shapes with a fill colour
+    size_t stroked = 0;  // shapes with a visible stroke
+    QRectF bounds;       // union of the bounding boxes, null when empty
+  };
+
+  void rebuild(const ShapeStore& shapes);
+  void insert(const ShapePtr& shape, ShapeStore::ZKey z);
+  void remove(const GraphicsObject* shape);
+  // re-read bounds and style after a shape changed
+  void update(const GraphicsObject* shape);
+  size_t size() const { return owner.size(); }
+
+  // shapes whose bounding box meets or lies inside the area, back to front
+  void intersecting(const QRectF& area, std::vector<ShapePtr>& out) const;
+  void containedIn(const QRectF& area, std::vector<ShapePtr>& out) const;
+  Stats stats() const;
+
+  // first of the candidates, front to back from the shape index, whose
+  // contains() accepts the point and that passes the filter
+  // circles, hexagons and lines among them are tested in batches by the
+  // geometry kernels, other shapes by contains()
+  ShapePtr topmostAt(QPointF p,
+                     const std::vector<const GraphicsObject*>& candidates,
+                     const Filter& filter = nullptr) const;
+
+ private:
+  enum StyleFlags : uint8_t { kNoFill = 1, kNoStroke = 2, kPointyTop = 4 };
+  // batch test answer of a row the kernels do not cover
+  static constexpr uint8_t kAskShape = 2;
+
+  std::vector<double> left, top, right, bottom;
+  // hit test arguments, center and radii of circles and hexagons or the
+  // endpoints of lines, zero for other shapes
+  std::array<std::vector<double>, 4> geom;
+  std::vector<float> strokeWidth;
+  std::vector<ShapeType> type;
+  std::vector<uint8_t> styleFlags;
+  std::vector<uint32_t> fillArgb, strokeArgb;
+  std::vector<ShapeStore::ZKey> z;
+  std::vector<ShapePtr> owner;  // only read for rows a scan selected
+  std::unordered_map<const GraphicsObject*, uint32_t> rowOf;
+
+  void capture(uint32_t row);
+  void resize(size_t rows);
+  void moveRow(uint32_t from, uint32_t to);
+  // shapes of the selected rows sorted back to front
+  void gather(std::vector<uint32_t>& rows, std::vector<ShapePtr>& out) const;
+  // per row 1 hit, 0 miss or kAskShape
+  void batchHits(const std::vector<uint32_t>& rows, double x, double y,
+                 std::vector<uint8_t>& hits) const;
+};
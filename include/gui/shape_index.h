@@ -0,0 +1,83 @@
+// shape_index.h
+// loose quadtree over shape bounding boxes used for hit tests and culling
+#pragma once
+#include <QPointF>
+#include <QRectF>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "gui/shape_store.h"
+#include "shapes/graphics_object.h"
+
+// spatial index kept next to the canvas shape store
+// every entry carries the store z key so queries can still pick the topmost
+// shape
+class ShapeIndex {
+ public:
+  using ShapePtr = std::shared_ptr<GraphicsObject>;
+
+  // replace index contents with every shape of the store
+  void rebuild(const ShapeStore& shapes);
+
+  // add a shape at its z key in the store, or drop one
+  void insert(const ShapePtr& shape, ShapeStore::ZKey z);
+  void remove(const GraphicsObject* shape);
+
+  // re-read bounds and stroke of a shape after it changed
+  // returns the paint bounds stored before the update (null if not indexed)
+  QRectF update(const ShapePtr& shape);
+
+  // cached bounds of an indexed shape (null if not indexed)
+  QRectF boundsOf(const GraphicsObject* shape) const;
+  QRectF paintBoundsOf(const GraphicsObject* shape) const;
+
+  // area touched when drawing a box with the given stroke width
+  static QRectF paintBounds(const QRectF& box, double strokeWidth);
+
+  // shapes whose hit box holds the point, front to back, the exact test
+  // is left to the caller
+  void candidatesAt(QPointF p, std::vector<const GraphicsObject*>& out) const;
+
+  // shapes whose paint bounds meet the area, back to front
+  void query(const QRectF& area, std::vector<ShapePtr>& out) const;
+
+ private:
+  // one indexed shape with its cached box and document order
+  struct Entry {
+    ShapePtr shape;
+    QRectF box;
+    double stroke = 0;
+    uint64_t z = 0;
+    int node = 0;
+    bool parked = false;  // stored in the root because it does not fit
+  };
+
+  // quadtree cell, items may overhang the cell by half its side
+  struct Node {
+    QRectF cell;
+    int depth = 0;
+    int children[4] = {-1, -1, -1, -1};
+    std::vector<Entry*> items;
+  };
+
+  std::unordered_map<const GraphicsObject*, Entry> entries;
+  std::vector<Node> nodes;
+  size_t overflow = 0;  // number of parked entries
+
+  // hit area of a box, lines and strokes accept clicks slightly outside
+  static QRectF hitBox(const QRectF& box);
+  static QRectF looseBounds(const Node& node);
+
+  // area used for placement, covers both the hit box and the paint bounds
+  static QRectF placeBox(const Entry& entry);
+  static void capture(Entry& entry);
+
+  void resetTree();
+  void place(Entry& entry);
+  void unplace(const Entry& entry);
+  void collect(int node, QPointF p, std::vector<const Entry*>& out) const;
+  void collect(int node, const QRectF& area,
+               std::vector<const Entry*>& out) const;
+};
@@ -0,0 +1,98 @@
+// shape_store.h
+// slot map of document shapes with stable ids and a separate z order
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "shapes/graphics_object.h"
+
+// shapes live in table addressed by id, the z order is a map from z key to
+// slot so removing a shape and putting it back at its old key are both
+// logarithmic and keep every other shape where it was
+class ShapeStore {
+ public:
+  using ShapePtr = std::shared_ptr<GraphicsObject>;
+  using ZKey = uint64_t;  // 0 means no key
+
+  // stays valid until the shape is removed, a reused slot gets a new
+  // generation so stale ids never resolve to another shape
+  struct Id {
+    uint32_t slot = UINT32_MAX;
+    uint32_t generation = 0;
+    bool operator==(const Id& o) const {
+      return slot == o.slot && generation == o.generation;
+    }
+  };
+
+ private:
+  struct Slot {
+    ShapePtr shape;
+    ZKey z = 0;
+    uint32_t generation = 0;
+  };
+  using Order = std::map<ZKey, uint32_t>;
+
+ public:
+  // walks shapes back to front
+  class const_iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = ShapePtr;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const ShapePtr*;
+    using reference = const ShapePtr&;
+
+    const_iterator(Order::const_iterator it, const ShapeStore* store)
+        : it(it), store(store) {}
+    const ShapePtr& operator*() const {
+      return store->table[it->second].shape;
+    }
+    const ShapePtr* operator->() const { return &**this; }
+    ZKey z() const { return it->first; }
+    const_iterator& operator++() { ++it; return *this; }
+    const_iterator& operator--() { --it; return *this; }
+    bool operator==(const const_iterator& o) const { return it == o.it; }
+    bool operator!=(const const_iterator& o) const { return it != o.it; }
+
+   private:
+    Order::const_iterator it;
+    const ShapeStore* store;
+  };
+
+  const_iterator begin() const { return {order.begin(), this}; }
+  const_iterator end() const { return {order.end(), this}; }
+  size_t size() const { return order.size(); }
+  bool empty() const { return order.empty(); }
+
+  // put a shape above every other one
+  Id insertTop(ShapePtr shape);
+  // put a shape back at the key it had, on top if that key is taken
+  Id insertAt(ShapePtr shape, ZKey z);
+  // returns the key the shape had, 0 if it was not stored
+  ZKey remove(const GraphicsObject* shape);
+  ShapePtr removeAt(ZKey z);
+
+  // replace everything, keys count up from 1 in the given order unless
+  // keys holds one increasing key per shape
+  void assign(const std::vector<ShapePtr>& shapes,
+              const std::vector<ZKey>& keys = {});
+  void clear();
+
+  ZKey zOf(const GraphicsObject* shape) const;
+  Id idOf(const GraphicsObject* shape) const;
+  ShapePtr get(Id id) const;  // null for a stale id
+  ShapePtr at(ZKey z) const;
+  const_iterator find(const GraphicsObject* shape) const;
+
+ private:
+  std::vector<Slot> table;  // slot storage, removed slots are reused
+  std::vector<uint32_t> freeSlots;
+  std::unordered_map<const GraphicsObject*, uint32_t> slotOf;
+  Order order;
+  ZKey nextZ = 1;  // keys are never handed out twice by insertTop
+};
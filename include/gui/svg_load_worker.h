@@ -0,0 +1,40 @@
+// svg_load_worker.h
+// background svg loader that hands shapes to the gui thread in batches
+#pragma once
+#include <QMetaType>
+#include <QObject>
+#include <QString>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "shapes/graphics_object.h"
+
+using ShapeBatch = std::vector<std::shared_ptr<GraphicsObject>>;
+Q_DECLARE_METATYPE(ShapeBatch)
+
+// lives in its own QThread, run() streams the file and emits one batch per
+// block so the canvas can show partial content while the rest is parsed
+class SvgLoadWorker : public QObject {
+  Q_OBJECT
+
+ private:
+  QString path;
+  double simplifyTolerance;
+  std::atomic<bool> cancelled{false};
+
+ public:
+  SvgLoadWorker(const QString& path, double simplifyTolerance);
+
+  // safe to call from any thread, run() stops after the current block
+  void cancel();
+
+ public slots:
+  void run();
+
+ signals:
+  void batchReady(ShapeBatch batch);
+  void progress(int percent);
+  // ok is false when the file could not be opened
+  void finished(bool ok, bool cancelled, size_t removedPoints);
+};
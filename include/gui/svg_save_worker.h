@@ -0,0 +1,35 @@
+// svg_save_worker.h
+// background svg writer that saves a snapshot of the document
+#pragma once
+#include <QObject>
+#include <QString>
+#include <memory>
+
+#include "gui/save_snapshot.h"
+
+// lives in its own QThread, run() serializes the snapshot shapes and
+// atomically replaces the target file with the result
+class SvgSaveWorker : public QObject {
+  Q_OBJECT
+
+ private:
+  QString path;
+  int width;
+  int height;
+  std::shared_ptr<SaveSnapshot> snapshot;
+  bool ok = false;
+
+ public:
+  SvgSaveWorker(const QString& path, int width, int height,
+                std::shared_ptr<SaveSnapshot> snapshot);
+
+ public slots:
+  void run();
+
+ public:
+  // false when the target was left untouched, read after the thread joined
+  bool succeeded() const;
+
+ signals:
+  void finished();
+};
@@ -0,0 +1,18 @@
+// binary_reader.h
+// reads native binary documents written by BinaryFormat::Writer
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "shapes/graphics_object.h"
+
+namespace BinaryFormat {
+
+// map the file and build its shapes in z order, ok is set to false when
+// the file is missing, truncated or not a native document, and when any
+// record was skipped, the shapes that could be read are still returned
+std::vector<std::shared_ptr<GraphicsObject>> load(const std::string& path,
+                                                  bool* ok = nullptr);
+
+}  // namespace BinaryFormat
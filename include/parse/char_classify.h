@@ -0,0 +1,23 @@
+// char_classify.h
+// per byte character classes of a 64 byte block, with simd kernels
+#pragma once
+#include <cstdint>
+
+namespace SvgParser {
+
+// bit i is set when block[i] is in the class
+struct CharMasks {
+  uint64_t separator = 0;  // space, tab, cr, lf or comma
+  uint64_t digit = 0;      // ascii 0 to 9
+};
+
+// classifies exactly 64 readable bytes
+using ClassifyFn = CharMasks (*)(const char* block);
+
+CharMasks classifyScalar(const char* block);
+
+// fastest kernel the running cpu supports, avx2 or sse4.2 on x86 and the
+// scalar loop everywhere else
+ClassifyFn selectClassifier();
+
+}  // namespace SvgParser
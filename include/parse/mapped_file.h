@@ -0,0 +1,28 @@
+// mapped_file.h
+// read only view of a whole file, memory mapped where the platform allows
+#pragma once
+#include <string>
+#include <string_view>
+
+// owns either a read only mapping or, as a fallback, one heap buffer
+// holding the file, data() stays valid until the object is destroyed
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  bool isOpen() const;
+  std::string_view data() const;
+
+ private:
+  const char* mapped = nullptr;  // mapping start, null when not mapped
+  size_t mappedSize = 0;
+  std::string buffer;  // fallback copy when mapping is unavailable
+  bool open = false;
+
+  bool map(const std::string& path);
+  bool readAll(const std::string& path);
+};
@@ -3,6 +3,7 @@
 #pragma once
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "shapes/graphics_object.h"
@@ -10,6 +11,15 @@
 namespace SvgParser {
 
 // parse an SVG file and return the shapes it contains.
-std::vector<std::shared_ptr<GraphicsObject>> load(const std::string& filePath);
+// a positive tolerance simplifies freehand strokes, the number of dropped
+// points is written to removedPoints when given
+std::vector<std::shared_ptr<GraphicsObject>> load(
+    const std::string& filePath, double simplifyTolerance = 0.0,
+    size_t* removedPoints = nullptr);
+
+// same as load but for svg text already in memory
+std::vector<std::shared_ptr<GraphicsObject>> parse(
+    std::string_view doc, double simplifyTolerance = 0.0,
+    size_t* removedPoints = nullptr);
 
 }  // namespace SvgParser
@@ -1,40 +1,108 @@
 // svg_parser_internal.h
 // helper functions for SVG parsing
 #pragma once
-#include <map>
+#include <QPointF>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "shapes/graphics_object.h"
+#include "shapes/shape_pool.h"
+#include "shapes/shape_style.h"
 
 // internal namespace for SVG parsing helpers and implementation details
 namespace SvgParser {
 
-// internal types for attribute maps and shape vectors
-using AttrMap = std::map<std::string, std::string>;
+// attribute names the parser understands, interned once per attribute
+enum class AttrKey : uint8_t {
+  X,
+  Y,
+  Width,
+  Height,
+  Rx,
+  Ry,
+  Cx,
+  Cy,
+  R,
+  X1,
+  Y1,
+  X2,
+  Y2,
+  Fill,
+  FillOpacity,
+  Stroke,
+  StrokeOpacity,
+  StrokeWidth,
+  FontFamily,
+  FontSize,
+  Points,
+  DataShape,
+  DataHighlightFill,
+  DataCx,
+  DataCy,
+  DataRx,
+  DataRy,
+  DataOrientation,
+  Unknown
+};
+
+// one attribute, the value points into the file buffer
+struct Attr {
+  AttrKey key;
+  std::string_view value;
+};
+
+// flat attribute list reused across tags, attributes the parser does not know
+// are dropped so it never needs to grow past a handful of entries
+struct AttrMap {
+  static constexpr int kMaxAttrs = 24;
+  Attr items[kMaxAttrs];
+  int count = 0;
+
+  const std::string_view* find(AttrKey key) const;
+};
+
+// shapes of one chunk until they are moved into the result
 using ShapeVec = std::vector<std::shared_ptr<GraphicsObject>>;
 
 // parsing helpers for attributes and colors
-AttrMap parseAttributes(const std::string& tag);
+AttrKey internKey(std::string_view name);
+void parseAttributes(std::string_view tag, AttrMap& out);
 
-double num(const AttrMap& m, const std::string& key, double fallback = 0.0);
+// parse a number with from_chars, fallback if missing or malformed
+double toNumber(std::string_view text, double fallback);
+double num(const AttrMap& m, AttrKey key, double fallback = 0.0);
 
 // get string attribute or fallback if not found
-std::string str(const AttrMap& m, const std::string& key,
-                const std::string& fallback = "");
+std::string_view str(const AttrMap& m, AttrKey key,
+                     std::string_view fallback = {});
 
 // unescape XML entities in a string (e.g. &lt; → <)
-std::string unescapeXml(std::string s);
-std::string rebuildColor(const AttrMap& m, const std::string& prefix);
+std::string unescapeXml(std::string_view s);
+ShapeColor rebuildColor(const AttrMap& m, AttrKey color, AttrKey opacity);
+
+// parse all elements of a run of svg text and simplify freehand strokes in it
+void parseRange(std::string_view doc, ShapeVec& shapes);
+size_t simplifyRange(const ShapeVec& shapes, double tolerance);
+
+// cut doc into about count pieces, each starting at an opening tag so no
+// element is split across two pieces
+std::vector<std::string_view> splitChunks(std::string_view doc, size_t count);
 
 // parsing helpers for specific SVG elements
 void parseRect(const AttrMap& a, ShapeVec& out);
 void parseCircle(const AttrMap& a, ShapeVec& out);
 void parseEllipse(const AttrMap& a, ShapeVec& out);
 void parseLine(const AttrMap& a, ShapeVec& out);
-void parseText(const AttrMap& a, const std::string& raw, ShapeVec& out);
+void parseText(const AttrMap& a, std::string_view raw, ShapeVec& out);
 void parsePolyline(const AttrMap& a, ShapeVec& out);
 void parsePolygon(const AttrMap& a, ShapeVec& out);
 
+// decode an svg points list straight into out, numbers are taken in x y
+// pairs and decoding stops at the first malformed one
+// returns how many points were appended
+size_t parsePointList(std::string_view text, PointBuffer& out);
+
 }  // namespace SvgParser
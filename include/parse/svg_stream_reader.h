@@ -0,0 +1,48 @@
+// svg_stream_reader.h
+// reads an svg file block by block and yields shapes as elements complete
+#pragma once
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "shapes/graphics_object.h"
+
+namespace SvgParser {
+
+// sax style reader with bounded memory: it holds one block of the file plus
+// the tail of an element that straddles the block end
+class StreamReader {
+ public:
+  explicit StreamReader(const std::string& path,
+                        double simplifyTolerance = 0.0);
+
+  bool isOpen() const;
+  bool atEnd() const;
+
+  // read the next block and append the shapes it completes, false at the end
+  bool next(std::vector<std::shared_ptr<GraphicsObject>>& out);
+
+  // bytes consumed so far out of the file size
+  size_t bytesRead() const;
+  size_t totalBytes() const;
+  size_t removedPoints() const;
+
+ private:
+  std::ifstream file;
+  std::string pending;  // unparsed bytes carried over to the next block
+  // bytes of pending already scanned, the start of the last element that
+  // may be incomplete, and whether that element is a still open text
+  size_t scanned = 0;
+  size_t cut = 0;
+  bool inText = false;
+  size_t fileSize = 0;
+  size_t consumed = 0;
+  size_t removed = 0;
+  double tolerance = 0.0;
+  bool done = false;
+
+  void scanForCut();
+};
+
+}  // namespace SvgParser
@@ -0,0 +1,105 @@
+// binary_format.h
+// layout of the native little endian document file and its writer
+#pragma once
+#include <QPointF>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "shapes/shape_type.h"
+
+class GraphicsObject;
+struct ShapeColor;
+
+namespace BinaryFormat {
+
+const char kMagic[4] = {'P', 'I', 'K', 'B'};
+const uint32_t kVersion = 1;
+const char kExtension[] = ".pikb";
+
+// file start, every offset is in bytes from the start of the file
+struct FileHeader {
+  char magic[4];
+  uint32_t version;
+  int32_t width;  // canvas size when saved
+  int32_t height;
+  uint32_t typeCount;   // entries in the type table
+  uint32_t recordSize;  // sizeof(ShapeRecord) of the writer
+  uint64_t shapeCount;
+  uint64_t typeTableOffset;
+  uint64_t recordsOffset;
+  uint64_t pointsOffset;  // x y double pairs of every freehand stroke
+  uint64_t pointCount;
+  uint64_t stringsOffset;  // utf8 bytes of text and font names
+  uint64_t stringBytes;
+};
+
+// maps the type ids used by records to type names
+struct TypeEntry {
+  uint8_t id;
+  char name[15];  // nul padded
+};
+
+// fill and stroke none flags and hexagon orientation
+// a named colour keeps a colour name qt does not know, fill or stroke then
+// holds the string table offset of the nul terminated name
+enum RecordFlags : uint8_t {
+  kFillNone = 1,
+  kStrokeNone = 2,
+  kPointyTop = 4,
+  kFillNamed = 8,
+  kStrokeNamed = 16,
+};
+
+// one fixed size record per shape in z order, geom holds the constructor
+// arguments of the shape type
+struct ShapeRecord {
+  uint8_t type;
+  uint8_t flags;
+  uint16_t reserved;
+  int32_t fontSize;
+  uint32_t fill;  // argb
+  uint32_t stroke;
+  double strokeWidth;
+  double geom[6];
+  uint64_t dataOffset;  // first point, or first string byte
+  uint64_t dataCount;   // points, or text bytes
+  uint64_t dataCount2;  // font family bytes following the text
+};
+
+static_assert(sizeof(FileHeader) == 80, "header layout changed");
+static_assert(sizeof(ShapeRecord) == 96, "record layout changed");
+static_assert(sizeof(QPointF) == 2 * sizeof(double), "points are copied");
+
+// one record of a mapped file with the point and string sections it indexes,
+// each shape class builds itself from it in fromRecord
+struct RecordView {
+  const ShapeRecord& rec;
+  const char* points;
+  const char* strings;
+};
+
+bool isBinaryPath(const std::string& path);
+
+// collects records, points and strings, then lays them out as a file
+class Writer {
+ private:
+  std::vector<ShapeRecord> records;
+  std::vector<QPointF> points;
+  std::string strings;
+
+  uint32_t colorValue(const ShapeColor& color, uint8_t namedFlag,
+                      uint8_t& flags);
+
+ public:
+  // new record with the style of shape filled in
+  ShapeRecord& add(ShapeType type, const GraphicsObject& shape);
+  uint64_t addPoints(const QPointF* pts, size_t count);
+  uint64_t addString(std::string_view text);
+
+  // the whole file, empty when the host is not little endian
+  std::string finish(int width, int height) const;
+};
+
+}  // namespace BinaryFormat
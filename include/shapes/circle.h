@@ -3,7 +3,7 @@
 #pragma once
 #include "shapes/graphics_object.h"
 
-class Circle : public GraphicsObject {
+class Circle final : public GraphicsObject {
  private:
   // center (cx, cy) and radii (rx, ry) for ellipse support
   double cx, cy;
@@ -16,11 +16,21 @@ class Circle : public GraphicsObject {
 
   // overrides for drawing, SVG conversion, hit testing, and bounding box
   void draw(QPainter& painter) const override;
-  std::string toSVG() const override;
+  void writeSVG(SvgWriter& out) const override;
+  void writeBinary(BinaryFormat::Writer& out) const override;
+  static std::shared_ptr<GraphicsObject> fromRecord(
+      const BinaryFormat::RecordView& in);
+  ShapeType type() const override { return ShapeType::Circle; }
   bool contains(double x, double y) const override;
 
   QRectF boundingBox() const override;
 
+  // center and radii, the arguments of the ellipse hit test
+  double getCx() const;
+  double getCy() const;
+  double getRx() const;
+  double getRy() const;
+
   // Setters
   void setRadius(double r);
   void setRadii(double rx, double ry);
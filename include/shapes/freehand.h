@@ -1,23 +1,73 @@
 // freehand.h
 // Freehand polyline shape (sequence of points)
 #pragma once
+#include <QPainterPath>
 #include <vector>
 
 #include "shapes/graphics_object.h"
+#include "shapes/shape_pool.h"
 
-class Freehand : public GraphicsObject {
+class Freehand final : public GraphicsObject {
  private:
-  std::vector<QPointF> points;  // ordered list of points composing the stroke
+  // ordered list of points composing the stroke
+  PointBuffer points{shapeMemory()};
+
+  // polyline through points, extended by addPoint and translated by moveBy
+  // other edits mark it stale and it is rebuilt on next use
+  mutable QPainterPath path;
+  mutable bool pathValid = true;
+
+  // min max extent, kept as numbers so zero sized boxes still merge
+  struct Extent {
+    double minX = 0, minY = 0, maxX = 0, maxY = 0;
+  };
+
+  // bvh node over a run of segments, segment i joins points i and i + 1
+  struct BvhNode {
+    Extent box;
+    int left = -1, right = -1;  // child nodes, both -1 for a leaf
+    int first = 0, count = 0;   // leaf range inside bvhOrder
+  };
+
+  // cached bounds grow with addPoint and move with moveBy
+  mutable Extent extent;
+  mutable bool extentValid = true;
+
+  // segment hierarchy for hit tests, built lazily on the first query
+  // leaf segments are copied out in bvhOrder as separate coordinate arrays
+  // so a leaf is one contiguous run for the distance kernel
+  mutable std::vector<BvhNode> bvh;
+  mutable std::vector<int> bvhOrder;
+  mutable std::vector<double> leafAx, leafAy, leafBx, leafBy;
+  mutable bool bvhValid = false;
+
+  void buildBvh() const;
+  int buildBvhNode(int first, int count) const;
+
+  // drop every cache after an edit that rewrote the points
+  void geometryChanged();
+
+  // squared distance from p to the segment a b
+  static double segmentDistSq(const QPointF& p, const QPointF& a,
+                              const QPointF& b);
 
  public:
   Freehand();  // default constructor for an empty freehand stroke
 
   void addPoint(double x, double y);  // append a point
-  const std::vector<QPointF>& getPoints() const;
+  const PointBuffer& getPoints() const;
+  void setPoints(PointBuffer pts);  // replace the whole stroke
+
+  // cached path shared by draw and the live stroke preview
+  const QPainterPath& getPath() const;
 
   // drawing, SVG conversion, hit testing, and bounding box overrides
   void draw(QPainter& painter) const override;
-  std::string toSVG() const override;
+  void writeSVG(SvgWriter& out) const override;
+  void writeBinary(BinaryFormat::Writer& out) const override;
+  static std::shared_ptr<GraphicsObject> fromRecord(
+      const BinaryFormat::RecordView& in);
+  ShapeType type() const override { return ShapeType::Freehand; }
   bool contains(double x, double y) const override;
   QRectF boundingBox() const override;
 
@@ -26,6 +76,10 @@ class Freehand : public GraphicsObject {
   std::shared_ptr<GraphicsObject> clone() const override;
   void setFromBoundingBox(const QRectF& box) override;
 
+  // remove points closer than tolerance pixels to the simplified stroke
+  // returns how many points were dropped
+  size_t simplify(double tolerance);
+
   // re-map points to fit inside the provided box
   void scaleToBox(double left, double top, double right, double bottom);
 };
@@ -0,0 +1,61 @@
+// geo_kernels.h
+// hit test and bounds kernels over contiguous coordinates, with simd versions
+#pragma once
+#include <QPointF>
+#include <cstddef>
+#include <cstdint>
+
+namespace GeoKernels {
+
+// min max extent of a run of points, zeros are always positive
+struct Extent {
+  double minX = 0, minY = 0, maxX = 0, maxY = 0;
+};
+
+// structure of arrays views of n shapes of one type
+struct Segments {
+  const double *ax, *ay, *bx, *by;
+  size_t n;
+};
+struct Ellipses {
+  const double *cx, *cy, *rx, *ry;
+  size_t n;
+};
+struct Hexagons {
+  const double *cx, *cy, *rx, *ry;
+  size_t n;
+  bool pointyTop;  // one orientation per batch
+};
+
+// reference versions of the per shape tests, the batch kernels give
+// bit for bit the same answers
+double segmentDistSq(double ax, double ay, double bx, double by, double px,
+                     double py);
+bool ellipseHit(double cx, double cy, double rx, double ry, double x,
+                double y);
+// odd even rule over the six corners, the same test QPolygonF uses
+bool hexagonHit(double cx, double cy, double rx, double ry, bool pointyTop,
+                double x, double y);
+
+// unit corner offsets of a hexagon, corner i is c + r * (cos[i], sin[i])
+struct HexUnit {
+  double cos[6], sin[6];
+};
+const HexUnit& hexUnit(bool pointyTop);
+
+// one set of kernels, n must be at least 1 for extent
+struct Kernels {
+  Extent (*extent)(const QPointF* points, size_t n);
+  void (*segmentDistSq)(const Segments& s, double px, double py,
+                        double* out);
+  void (*ellipseHits)(const Ellipses& e, double x, double y, uint8_t* hits);
+  void (*hexagonHits)(const Hexagons& h, double x, double y, uint8_t* hits);
+};
+
+// scalar loops over the reference functions
+const Kernels& scalarKernels();
+// fastest set the running cpu supports, avx2 or sse2 on x86 and the scalar
+// loops everywhere else, picked once
+const Kernels& kernels();
+
+}  // namespace GeoKernels
@@ -0,0 +1,19 @@
+// geo_kernels_internal.h
+// simd kernel sets shared between the geometry kernel translation units
+#pragma once
+#include "shapes/geo_kernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GEO_X86_KERNELS 1
+#endif
+
+namespace GeoKernels {
+
+#ifdef GEO_X86_KERNELS
+// every kernel repeats the operations of the scalar reference in the same
+// order, tails fall back to the reference functions
+const Kernels& sse2Kernels();
+const Kernels& avx2Kernels();
+#endif
+
+}  // namespace GeoKernels
@@ -3,20 +3,34 @@
 #pragma once
 #include <QPainter>
 #include <QRectF>
+#include <cstdint>
 #include <string>
 
+#include "shapes/shape_style.h"
+#include "shapes/shape_type.h"
+
+class SvgWriter;
+namespace BinaryFormat {
+class Writer;
+struct RecordView;
+}
+
 class GraphicsObject {
  protected:
   // basic visual properties of the bounding box and colorus
   double width;
   double height;
   double strokeWidth;
-  std::string fillColor;
-  std::string strokeColor;
+  ShapeColor fillColor;
+  ShapeColor strokeColor;
 
-  // convert stored colour strings to SVG
-  static std::string svgColorAttr(const std::string& prefix,
-                                  const std::string& color);
+  // ready to use pen and brush rebuilt whenever the style changes
+  // subclasses set cap and join styles once in their constructors
+  QPen strokePen;
+  QBrush fillBrush;
+
+  // stroke, stroke-width and fill attributes shared by the closed shapes
+  void writeStrokeAndFill(SvgWriter& out) const;
 
  public:
   GraphicsObject();
@@ -24,17 +38,27 @@ class GraphicsObject {
 
   // polymorphic interface for drawing, hit-testing and SVG conversion
   virtual void draw(QPainter& painter) const = 0;
-  virtual std::string toSVG() const = 0;
+  virtual void writeSVG(SvgWriter& out) const = 0;
+  virtual void writeBinary(BinaryFormat::Writer& out) const = 0;
+  virtual ShapeType type() const = 0;
   virtual bool contains(double x, double y) const = 0;
 
   // colour and stroke accessors (common implementation).
+  // string forms are for the properties panel and svg, the rest use packed
   void setStrokeColor(const std::string& color);
   void setFillColor(const std::string& color);
+  void setStrokeColor(const ShapeColor& color);
+  void setFillColor(const ShapeColor& color);
   void setStrokeWidth(double w);
   std::string getStrokeColor() const;
   std::string getFillColor() const;
+  const ShapeColor& getStroke() const;
+  const ShapeColor& getFill() const;
   double getStrokeWidth() const;
 
+  // copy fill, stroke and stroke width from another shape
+  void copyStyleFrom(const GraphicsObject& other);
+
   // geometry accessors and mutators
   // width and height are stored via the bounding box
   virtual QRectF boundingBox() const = 0;
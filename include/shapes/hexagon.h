@@ -3,7 +3,7 @@
 #pragma once
 #include "shapes/graphics_object.h"
 
-class Hexagon : public GraphicsObject {
+class Hexagon final : public GraphicsObject {
  private:
   // center and radii (half-width, half-height) defining the bounding box
   double cx, cy, rx, ry;
@@ -16,10 +16,20 @@ class Hexagon : public GraphicsObject {
 
   // polymorphic overrides for drawing, hit-testing, bounding box and cloning
   void draw(QPainter& painter) const override;
-  std::string toSVG() const override;
+  void writeSVG(SvgWriter& out) const override;
+  void writeBinary(BinaryFormat::Writer& out) const override;
+  static std::shared_ptr<GraphicsObject> fromRecord(
+      const BinaryFormat::RecordView& in);
+  ShapeType type() const override { return ShapeType::Hexagon; }
   bool contains(double x, double y) const override;
   QRectF boundingBox() const override;
 
+  // center and radii, the arguments of the hexagon hit test
+  double getCx() const;
+  double getCy() const;
+  double getRx() const;
+  double getRy() const;
+
   // geometry mutators and helpers
   void setCenter(double x, double y);
   void setRadii(double rx, double ry);
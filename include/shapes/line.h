@@ -3,7 +3,7 @@
 #pragma once
 #include "shapes/graphics_object.h"
 
-class Line : public GraphicsObject {
+class Line final : public GraphicsObject {
  private:
   double x1, y1, x2, y2;  // endpoints
 
@@ -12,8 +12,14 @@ class Line : public GraphicsObject {
   Line(double x1, double y1, double x2, double y2);
 
   void draw(QPainter& painter) const override;
-  std::string toSVG() const override;
+  void writeSVG(SvgWriter& out) const override;
+  void writeBinary(BinaryFormat::Writer& out) const override;
+  static std::shared_ptr<GraphicsObject> fromRecord(
+      const BinaryFormat::RecordView& in);
+  ShapeType type() const override { return ShapeType::Line; }
   bool contains(double x, double y) const override;  // hit test near segment
+  // distance from the segment a click still hits
+  static constexpr double kHitDistance = 5.0;
   QRectF boundingBox() const override;
 
   // geometry accessors and mutators
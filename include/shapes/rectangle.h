@@ -3,7 +3,7 @@
 #pragma once
 #include "shapes/graphics_object.h"
 
-class Rectangle : public GraphicsObject {
+class Rectangle final : public GraphicsObject {
  private:
   // position for rectangle
   double x;
@@ -15,7 +15,11 @@ class Rectangle : public GraphicsObject {
 
   // drawing, SVG conversion, hit testing, and bounding box overrides
   void draw(QPainter& painter) const override;
-  std::string toSVG() const override;
+  void writeSVG(SvgWriter& out) const override;
+  void writeBinary(BinaryFormat::Writer& out) const override;
+  static std::shared_ptr<GraphicsObject> fromRecord(
+      const BinaryFormat::RecordView& in);
+  ShapeType type() const override { return ShapeType::Rectangle; }
   bool contains(double mouseX, double mouseY) const override;
   QRectF boundingBox() const override;
 
@@ -3,7 +3,7 @@
 #pragma once
 #include "shapes/graphics_object.h"
 
-class RoundedRectangle : public GraphicsObject {
+class RoundedRectangle final : public GraphicsObject {
  private:
   double x, y;    // top-left
   double rx, ry;  // corner radii
@@ -15,7 +15,11 @@ class RoundedRectangle : public GraphicsObject {
 
   // drawing, SVG conversion, hit testing, and bounding box overrides
   void draw(QPainter& painter) const override;
-  std::string toSVG() const override;
+  void writeSVG(SvgWriter& out) const override;
+  void writeBinary(BinaryFormat::Writer& out) const override;
+  static std::shared_ptr<GraphicsObject> fromRecord(
+      const BinaryFormat::RecordView& in);
+  ShapeType type() const override { return ShapeType::RoundedRectangle; }
   bool contains(double mouseX, double mouseY) const override;
   QRectF boundingBox() const override;
 
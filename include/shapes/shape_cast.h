@@ -0,0 +1,42 @@
+// shape_cast.h
+// checked downcasts by type tag instead of rtti
+#pragma once
+#include <memory>
+#include <type_traits>
+
+#include "shapes/graphics_object.h"
+
+// tag of each concrete shape class, generated from SHAPE_TYPES
+template <class T>
+struct ShapeTraits;
+
+#define SHAPE_TRAITS(tag, cls, name)                     \
+  class cls;                                             \
+  template <>                                            \
+  struct ShapeTraits<cls> {                              \
+    static constexpr ShapeType type = ShapeType::tag;    \
+  };
+SHAPE_TYPES(SHAPE_TRAITS)
+#undef SHAPE_TRAITS
+
+// the shape as T when its tag says so, null otherwise
+// one virtual call and a compare where dynamic_cast walked the type info,
+// exact because every shape class is final
+template <class T>
+T* shapeCast(GraphicsObject* shape) {
+  static_assert(std::is_final_v<T>, "shape classes must be final");
+  return shape && shape->type() == ShapeTraits<T>::type
+             ? static_cast<T*>(shape)
+             : nullptr;
+}
+
+template <class T>
+const T* shapeCast(const GraphicsObject* shape) {
+  return shapeCast<T>(const_cast<GraphicsObject*>(shape));
+}
+
+// borrows from the shared pointer, no reference count traffic
+template <class T>
+T* shapeCast(const std::shared_ptr<GraphicsObject>& shape) {
+  return shapeCast<T>(shape.get());
+}
@@ -0,0 +1,36 @@
+// shape_pool.h
+// pooled allocation for shape objects and their point buffers
+#pragma once
+#include <QPointF>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+// size class pool every shape and small point buffer comes from, so a
+// closed document hands its blocks back for the next one instead of
+// returning a million small blocks to the general heap
+// thread safe, the parser builds shapes on worker threads
+std::pmr::memory_resource* shapeMemory();
+
+// later shapes come from a pool of their own, so the shapes of an opened
+// document do not share blocks with the one it replaces
+// gui thread only, with no load running
+void beginShapeGeneration();
+
+// hand the blocks of every pool with no shape or point buffer alive back
+// to the heap, returns false if some pool is still in use
+// gui thread only, with no load running
+bool releaseShapeMemory();
+
+// like std::make_shared, object and control block share one pool block
+template <class T, class... Args>
+std::shared_ptr<T> allocateShape(Args&&... args) {
+  return std::allocate_shared<T>(
+      std::pmr::polymorphic_allocator<T>(shapeMemory()),
+      std::forward<Args>(args)...);
+}
+
+// freehand stroke points, moving a buffer built on shapeMemory() into a
+// shape takes it over without copying
+using PointBuffer = std::pmr::vector<QPointF>;
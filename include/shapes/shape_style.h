@@ -0,0 +1,33 @@
+// shape_style.h
+// packed colour used for shape fill and stroke instead of colour strings
+#pragma once
+#include <QColor>
+#include <string>
+#include <string_view>
+
+// 32 bit argb colour plus flags, strings are only parsed or produced at the
+// svg and properties panel boundaries
+struct ShapeColor {
+  QRgb argb = 0;
+  bool none = true;  // "none", "transparent" and unknown colours
+  // colour text qt does not understand, drawn as none but saved as written
+  // argb then holds the id of the text in a table shared by all shapes
+  bool named = false;
+
+  // parse any colour name qt understands, unknown names are kept by id
+  static ShapeColor fromString(const std::string& color);
+  static ShapeColor fromQColor(const QColor& color);
+
+  // the unknown colour text, empty unless named
+  std::string_view name() const;
+  // the unknown name, "transparent" for none, otherwise #aarrggbb
+  std::string toString() const;
+  QColor toQColor() const;
+
+  // one id per distinct name, so named colours compare by id
+  bool operator==(const ShapeColor& other) const {
+    return none == other.none && named == other.named &&
+           ((none && !named) || argb == other.argb);
+  }
+  bool operator!=(const ShapeColor& other) const { return !(*this == other); }
+};
@@ -0,0 +1,26 @@
+// shape_type.h
+// tag naming the concrete class of a shape
+#pragma once
+#include <cstdint>
+
+// every concrete shape as X(tag, class, file format name), in tag order
+// adding a shape is one line here plus its final class, the enum, names,
+// shapeCast and visitShape are all generated from this list
+#define SHAPE_TYPES(X)                                  \
+  X(Rectangle, Rectangle, "rectangle")                  \
+  X(RoundedRectangle, RoundedRectangle, "rounded_rect") \
+  X(Circle, Circle, "ellipse")                          \
+  X(Line, Line, "line")                                 \
+  X(Hexagon, Hexagon, "hexagon")                        \
+  X(Freehand, Freehand, "freehand")                     \
+  X(Text, TextShape, "text")
+
+enum class ShapeType : uint8_t {
+#define SHAPE_TYPE_TAG(tag, cls, name) tag,
+  SHAPE_TYPES(SHAPE_TYPE_TAG)
+#undef SHAPE_TYPE_TAG
+  Count
+};
+
+// stable name used by file formats, independent of the enum order
+const char* shapeTypeName(ShapeType type);
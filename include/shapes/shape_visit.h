@@ -0,0 +1,39 @@
+// shape_visit.h
+// switch dispatch over the closed set of shape classes
+#pragma once
+#include <QtGlobal>
+#include <type_traits>
+
+#include "shapes/circle.h"
+#include "shapes/freehand.h"
+#include "shapes/hexagon.h"
+#include "shapes/line.h"
+#include "shapes/rectangle.h"
+#include "shapes/rounded_rectangle.h"
+#include "shapes/shape_cast.h"
+#include "shapes/text_shape.h"
+
+// false for every T, for the static_assert closing an if constexpr chain
+// the assert only fires once the chain is instantiated for an unhandled T
+template <class T>
+inline constexpr bool alwaysFalse = false;
+
+// call fn with the shape as its concrete class, fn is typically a generic
+// lambda using if constexpr per class
+// every case of the switch is generated from SHAPE_TYPES, so a new shape
+// that fn cannot take fails to compile here, a lambda whose chain ends in
+// static_assert(alwaysFalse<T>) must name every class
+template <class Fn>
+auto visitShape(GraphicsObject& shape, Fn&& fn)
+    -> std::invoke_result_t<Fn, Rectangle&> {
+  switch (shape.type()) {
+#define SHAPE_VISIT(tag, cls, name) \
+  case ShapeType::tag:              \
+    return fn(static_cast<cls&>(shape));
+    SHAPE_TYPES(SHAPE_VISIT)
+#undef SHAPE_VISIT
+    default:
+      // every shape reports one of the listed types
+      Q_UNREACHABLE();
+  }
+}
@@ -0,0 +1,28 @@
+// svg_document.h
+// serializes a whole shape list into an svg document
+#pragma once
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "shapes/graphics_object.h"
+#include "shapes/svg_writer.h"
+
+// appends the svg root element with every shape in order to out
+// large documents are split into ranges written on worker threads, the
+// output is the same bytes a single threaded pass produces
+void writeSvgDocument(
+    SvgWriter& out, int width, int height,
+    const std::vector<std::shared_ptr<GraphicsObject>>& shapes);
+
+// appends shapes [first, last) of a document to out
+using SvgRangeWriter =
+    std::function<void(SvgWriter& out, size_t first, size_t last)>;
+
+// the same document for count shapes handed out range by range, for
+// callers that guard their shapes while a range is written
+void writeSvgDocument(SvgWriter& out, int width, int height, size_t count,
+                      const SvgRangeWriter& writeRange);
+
+// one shape element on its own indented line, as the document has it
+void writeSvgShape(SvgWriter& out, const GraphicsObject& shape);
@@ -0,0 +1,36 @@
+// svg_writer.h
+// appends svg markup into one reusable buffer without per value temporaries
+#pragma once
+#include <string>
+#include <string_view>
+
+#include "shapes/shape_style.h"
+
+class SvgWriter {
+ private:
+  std::string buf;
+
+ public:
+  // keep the capacity so the next document reuses the same allocation
+  void clear();
+  void reserve(size_t bytes);
+  const std::string& data() const;
+
+  // markup written as is
+  SvgWriter& raw(std::string_view text);
+  // text with xml special characters escaped
+  SvgWriter& escaped(std::string_view text);
+  // shortest text that reads back as exactly the same double
+  SvgWriter& number(double value);
+  // "x,y" pair for points lists
+  SvgWriter& point(double x, double y);
+
+  // attributes start with a space, name="value"
+  SvgWriter& attr(std::string_view name, double value);
+  SvgWriter& attr(std::string_view name, std::string_view value);
+
+  // name="#rrggbb" plus name-opacity when not opaque, name="none" for none
+  SvgWriter& color(std::string_view name, const ShapeColor& c);
+  // #aarrggbb or transparent, the same text as ShapeColor::toString
+  SvgWriter& colorString(const ShapeColor& c);
+};
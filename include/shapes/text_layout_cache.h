@@ -0,0 +1,19 @@
+// text_layout_cache.h
+// process wide cache of fonts and font metrics used by text shapes
+#pragma once
+#include <QFont>
+#include <QFontMetricsF>
+#include <memory>
+#include <string>
+
+// font plus its metrics, built once per family and size
+struct TextFont {
+  QFont font;
+  QFontMetricsF metrics;
+
+  explicit TextFont(const QFont& f) : font(f), metrics(f) {}
+};
+
+// the cache keeps the most recently used fonts only, the returned font
+// stays valid for as long as the caller holds it
+std::shared_ptr<const TextFont> textFont(const std::string& family, int size);
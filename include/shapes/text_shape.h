@@ -2,27 +2,38 @@
 // TextShape represents a single-line text object with font properties
 #pragma once
 
+#include <QPainterPath>
 #include <string>
 
 #include "shapes/graphics_object.h"
 
-class TextShape : public GraphicsObject {
+class TextShape final : public GraphicsObject {
  private:
-  // helper to escape special characters in XML output
-  static std::string escapeXml(const std::string& s);
-
   double x;  // x position (left)
   double y;  // y position (baseline)
   std::string text;
   std::string fontFamily = "Arial";
   int fontSize = 16;
 
+  // glyph outline and box, rebuilt lazily after text or font changes and
+  // translated in place on moves
+  mutable QPainterPath glyphPath;
+  mutable QRectF layoutBox;
+  mutable bool layoutValid = false;
+
+  void ensureLayout() const;
+  void invalidateLayout();
+
  public:
   TextShape(double x, double y, const std::string& text = "");
 
   // render text using QPainter, convert to SVG <text> element, and hit test
   void draw(QPainter& painter) const override;
-  std::string toSVG() const override;
+  void writeSVG(SvgWriter& out) const override;
+  void writeBinary(BinaryFormat::Writer& out) const override;
+  static std::shared_ptr<GraphicsObject> fromRecord(
+      const BinaryFormat::RecordView& in);
+  ShapeType type() const override { return ShapeType::Text; }
   bool contains(double x, double y) const override;
   QRectF boundingBox() const override;
 
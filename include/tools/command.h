@@ -3,7 +3,8 @@
 #pragma once
 #include <QRectF>
 #include <memory>
-#include <vector>
+
+#include "gui/shape_store.h"
 
 class Canvas;
 class GraphicsObject;
@@ -16,9 +17,11 @@ class Command {
 };
 
 // adding a shape to the canvas
+// undo remembers the z key so redo puts the shape back at the same place
 class AddShapeCommand : public Command {
  private:
   std::shared_ptr<GraphicsObject> shape;
+  ShapeStore::ZKey z = 0;
 
  public:
   explicit AddShapeCommand(std::shared_ptr<GraphicsObject> s);
@@ -27,12 +30,14 @@ class AddShapeCommand : public Command {
 };
 
 // removing a shape by deleting or cutting from canvas
+// z is the key the shape had, undo restores it between the same neighbours
 class RemoveShapeCommand : public Command {
  private:
   std::shared_ptr<GraphicsObject> shape;
+  ShapeStore::ZKey z;
 
  public:
-  explicit RemoveShapeCommand(std::shared_ptr<GraphicsObject> s);
+  RemoveShapeCommand(std::shared_ptr<GraphicsObject> s, ShapeStore::ZKey z);
   void undo(Canvas* canvas) override;
   void redo(Canvas* canvas) override;
 };
@@ -65,12 +70,11 @@ class ResizeCommand : public Command {
 // clearing all shapes from the canvas (used for new and clear all)
 class ClearAllCommand : public Command {
  private:
-  std::vector<std::shared_ptr<GraphicsObject>> saved;
+  ShapeStore saved;
   std::shared_ptr<GraphicsObject> savedSelection;
 
  public:
-  ClearAllCommand(std::vector<std::shared_ptr<GraphicsObject>> shapes,
-                  std::shared_ptr<GraphicsObject> sel);
+  ClearAllCommand(ShapeStore shapes, std::shared_ptr<GraphicsObject> sel);
   void undo(Canvas* canvas) override;
   void redo(Canvas* canvas) override;
 };
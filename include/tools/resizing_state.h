@@ -4,6 +4,7 @@
 #include <QPointF>
 #include <vector>
 
+#include "shapes/shape_pool.h"
 #include "tools/canvas_state.h"
 #include "tools/handle_helpers.h"
 
@@ -31,7 +32,7 @@ class ResizingState : public CanvasState {
   void handleMouseRelease(Canvas* canvas, QMouseEvent* event) override;
 
   // call after construction to snapshot freehand points
-  void snapshotFreehandPoints(const std::vector<QPointF>& pts);
+  void snapshotFreehandPoints(const PointBuffer& pts);
 
   // apply non-line resizing
   void applyResize(Canvas* canvas, QPointF pos);
@@ -17,6 +17,8 @@ struct CreationDefaults {
   bool hexPointyTop;
   std::string fontFamily;
   int fontSize;
+  double simplifyTolerance;  // freehand simplification in pixels, 0 is off
+  bool simplifyOnImport;     // also simplify freehand strokes when opening
 };
 
 // getter/setter for the global creation defaults
@@ -4,6 +4,7 @@
 #include <QApplication>
 
 #include "gui/app_style.h"  // global style helper
+#include "gui/canvas.h"
 #include "gui/main_window.h"
 
 int main(int argc, char* argv[]) {
@@ -14,5 +15,6 @@ int main(int argc, char* argv[]) {
 
   MainWindow window;
   window.show();
+  window.getCanvas()->startJournal();  // crash recovery prompt
   return app.exec();
 }
@@ -35,11 +35,24 @@ Canvas::Canvas(QWidget* parent) : QWidget(parent) {
           [this]() { finalizeTextEditing(); });
 }
 
-Canvas::~Canvas() = default;
+// running background load and save must be joined before the canvas goes
+// away, a pending save still finishes writing its file
+// a clean close removes the journal, only a crash leaves it behind
+Canvas::~Canvas() {
+  stopLoadThread();
+  if (saveWorker) joinSaveThread();
+  journal.discard();
+}
 
 // dispatch mouse events to current fsm object
+// while a file streams in a press only selects, edits wait for the load
 void Canvas::mousePressEvent(QMouseEvent* e) {
   if (textEditing) finalizeTextEditing();
+  if (isLoading()) {
+    if (e->button() == Qt::LeftButton)
+      setSelectedShape(shapeAt(e->position()));
+    return;
+  }
   currentState->handleMousePress(this, e);
 }
 
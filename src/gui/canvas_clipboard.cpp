@@ -1,19 +1,16 @@
 // canvas_clipboard.cpp
 // cut/copy/paste/delete/clear commands
-#include <algorithm>
-
 #include "gui/canvas.h"
 #include "tools/command.h"
 
 // clipboard operations for cut/copy/paste/delete/clear commands
+// copying is fine during a load, the edits wait until it finished
 void Canvas::deleteSelected() {
-  if (!selectedShape) return;
+  if (!selectedShape || isLoading()) return;
   auto removedShape = selectedShape;
-  shapes.erase(std::remove(shapes.begin(), shapes.end(), removedShape),
-               shapes.end());
+  ShapeStore::ZKey z = removeShape(removedShape);
   setSelectedShape(nullptr);
-  pushCommand(std::make_unique<RemoveShapeCommand>(removedShape));
-  update();
+  pushCommand(std::make_unique<RemoveShapeCommand>(removedShape, z));
 }
 
 void Canvas::copySelected() {
@@ -22,30 +19,28 @@ void Canvas::copySelected() {
 
 // cut copies then deletes the selected shape
 void Canvas::cutSelected() {
-  if (!selectedShape) return;
+  if (!selectedShape || isLoading()) return;
   clipboard = selectedShape->clone();
   deleteSelected();
 }
 
 // paste creates a clone of the clipboard shape and adds it to the document
 void Canvas::pasteAtCursor() {
-  if (!clipboard) return;
+  if (!clipboard || isLoading()) return;
   auto shape = clipboard->clone();
   QRectF box = shape->boundingBox();
   shape->moveBy(lastMousePos.x() - box.center().x(),
                 lastMousePos.y() - box.center().y());
-  shapes.push_back(shape);
+  addShape(shape);
   setSelectedShape(shape);
   pushCommand(std::make_unique<AddShapeCommand>(shape));
-  update();
 }
 
 // clear all deletes all shapes and clears selection with a single command
 void Canvas::clearAll() {
-  if (shapes.empty()) return;
+  if (shapes.empty() || isLoading()) return;
   auto clearCmd = std::make_unique<ClearAllCommand>(shapes, selectedShape);
-  shapes.clear();
+  setShapes({});
   setSelectedShape(nullptr);
   pushCommand(std::move(clearCmd));
-  update();
 }
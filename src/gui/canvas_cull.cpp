@@ -0,0 +1,41 @@
+// canvas_cull.cpp
+// culling stage that picks the shapes a paint event actually has to draw
+
+#include <QRegion>
+
+#include "gui/canvas.h"
+
+namespace {
+// the exposed region can be several disjoint rects, its bounding rect alone
+// would keep shapes sitting in the gaps between them
+bool meetsRegion(const QRectF& bounds, const QRegion& region) {
+  for (const QRect& r : region) {
+    if (bounds.intersects(QRectF(r))) return true;
+  }
+  return false;
+}
+}  // namespace
+
+// shapes to draw for the exposed region, back to front
+// anything outside the widget, the region, or hidden by the text editor is
+// culled and counted for lastPaintStats()
+void Canvas::cullShapes(const QRegion& exposed,
+                        std::vector<std::shared_ptr<GraphicsObject>>& out) {
+  QRectF area = QRectF(exposed.boundingRect()).intersected(QRectF(rect()));
+  out.clear();
+  if (!area.isEmpty()) shapeIndex.query(area, out);
+
+  size_t kept = 0;
+  for (size_t i = 0; i < out.size(); i++) {
+    const auto& shape = out[i];
+    if (textEditing && shape == selectedShape) continue;
+    if (!meetsRegion(shapeIndex.paintBoundsOf(shape.get()), exposed)) continue;
+    out[kept++] = shape;
+  }
+  out.resize(kept);
+
+  paintStats.drawn = kept;
+  paintStats.culled = shapes.size() - kept;
+}
+
+const Canvas::PaintStats& Canvas::lastPaintStats() const { return paintStats; }
@@ -1,27 +1,26 @@
 // canvas_events.cpp
 // implementation for canvas events
 
-#include <QFont>
 #include <QLineEdit>
 #include <algorithm>
 #include <cmath>
 
 #include "gui/canvas.h"
+#include "shapes/shape_cast.h"
+#include "shapes/text_layout_cache.h"
 #include "shapes/text_shape.h"
 #include "tools/idle_state.h"
 
 // double clicking on a text shape starts inline text editing
 void Canvas::mouseDoubleClickEvent(QMouseEvent* e) {
-  if (e->button() != Qt::LeftButton) return;
+  if (e->button() != Qt::LeftButton || isLoading()) return;
   QPointF click = e->position();
-  for (auto it = shapes.rbegin(); it != shapes.rend(); ++it) {
-    auto txt = std::dynamic_pointer_cast<TextShape>(*it);
-    if (txt && txt->contains(click.x(), click.y())) {
-      setSelectedShape(*it);
-      beginTextEditing(true);
-      update();
-      return;
-    }
+  auto hit = shapeAt(click, [](const GraphicsObject& s) {
+    return s.type() == ShapeType::Text;
+  });
+  if (hit) {
+    setSelectedShape(hit);
+    beginTextEditing(true);
   }
 }
 
@@ -32,19 +31,16 @@ void Canvas::keyPressEvent(QKeyEvent* e) {
     setFocus();
     return;
   }
+  if (isLoading()) return;
   currentState->handleKeyPress(this, e);
 }
 
 // switch the fsm state to idle on mouse press if not handled by current state
 void Canvas::setState(std::unique_ptr<CanvasState> newState) {
+  dropStaticLayer();
   currentState = std::move(newState);
 }
 
-// expose mutable shape list for commands and interaction states
-std::vector<std::shared_ptr<GraphicsObject>>& Canvas::getShapes() {
-  return shapes;
-}
-
 // expose mutable selected shape pointer
 std::shared_ptr<GraphicsObject>& Canvas::getSelectedShape() {
   return selectedShape;
@@ -56,7 +52,12 @@ std::shared_ptr<GraphicsObject>& Canvas::getPreviewShape() {
 }
 
 // update selected shape and notify listeners like the properties panel
+// old and new selection are repainted so their handles appear or disappear
 void Canvas::setSelectedShape(std::shared_ptr<GraphicsObject> shape) {
+  if (shape != selectedShape) {
+    invalidateShape(selectedShape);
+    invalidateShape(shape);
+  }
   selectedShape = std::move(shape);
   emit selectionChanged();
 }
@@ -64,6 +65,7 @@ void Canvas::setSelectedShape(std::shared_ptr<GraphicsObject> shape) {
 // update preview shape used while creating shapes
 void Canvas::setPreviewShape(std::shared_ptr<GraphicsObject> shape) {
   previewShape = std::move(shape);
+  previewChanged();
 }
 
 // read active interaction mode
@@ -74,7 +76,7 @@ void Canvas::setMode(ShapeMode mode) { currentMode = mode; }
 
 // place and focus inline editor on top of selected text shape
 void Canvas::beginTextEditing(bool selectAll) {
-  auto txt = std::dynamic_pointer_cast<TextShape>(selectedShape);
+  auto txt = shapeCast<TextShape>(selectedShape);
   if (!txt || !textEditor) {
     textEditing = false;
     return;
@@ -82,10 +84,11 @@ void Canvas::beginTextEditing(bool selectAll) {
 
   textEditing = true;
   textBeforeEditing = txt->getText();
+  invalidateShape(selectedShape);
 
   // mirror text shape properties in the editor widget
-  QFont font(QString::fromStdString(txt->getFontFamily()), txt->getFontSize());
-  textEditor->setFont(font);
+  auto tf = textFont(txt->getFontFamily(), txt->getFontSize());
+  textEditor->setFont(tf->font);
   textEditor->setText(QString::fromStdString(txt->getText()));
 
   // position editor on top of text shape with some padding
@@ -109,6 +112,7 @@ void Canvas::beginTextEditing(bool selectAll) {
 
 // hide editor and apply text changes to the shape
 void Canvas::endTextEditing() {
+  if (textEditing) invalidateShape(selectedShape);
   textEditing = false;
   if (textEditor) textEditor->hide();
 }
@@ -3,38 +3,25 @@
 
 #include <QFileDialog>
 #include <QMessageBox>
-#include <fstream>
 
 #include "gui/canvas.h"
 #include "gui/unsaved_changes_dialog.h"
-#include "parse/svg_parser.h"
-
-// save current document to current file path
-// update saved snapshot after successful write
-void Canvas::save() {
-  if (currentFilePath.isEmpty()) {
-    saveAs();
-    return;
-  }
-  std::ofstream file(currentFilePath.toStdString());
-  if (!file.is_open()) return;
-
-  file << "<svg width=\"" << width() << "\" height=\"" << height()
-       << "\" xmlns=\"http://www.w3.org/2000/svg\">\n";
-
-  for (const auto& shape : shapes) file << "  " << shape->toSVG() << "\n";
-
-  file << "</svg>\n";
-
-  savedXml = computeDocumentXml();
-  syncModifiedState();
-}
+#include "parse/binary_reader.h"
+#include "shapes/binary_format.h"
+#include "shapes/shape_pool.h"
+#include "tools/shape_style_defaults.h"
 
 // ask user for a path, then call save
+// the extension picks the format, svg unless the native one is chosen
 void Canvas::saveAs() {
-  QString path = QFileDialog::getSaveFileName(this, "Save SVG", QString(),
-                                              "SVG Files (*.svg)");
+  QString filter;
+  QString path = QFileDialog::getSaveFileName(
+      this, "Save", QString(), "SVG Files (*.svg);;Native Documents (*.pikb)",
+      &filter);
   if (path.isEmpty()) return;
+  if (filter.startsWith("Native") &&
+      !BinaryFormat::isBinaryPath(path.toStdString()))
+    path += BinaryFormat::kExtension;
   currentFilePath = path;
   save();
 }
@@ -49,49 +36,54 @@ void Canvas::openFile() {
         "this editor reads a restricted svg subset and is most reliable with svg files saved by this app");
     shownSvgLimitNote = true;
   }
-  QString path = QFileDialog::getOpenFileName(this, "Open SVG", QString(),
-                                              "SVG Files (*.svg)");
+  QString path = QFileDialog::getOpenFileName(
+      this, "Open", QString(), "Documents (*.svg *.pikb);;SVG Files (*.svg)");
   if (path.isEmpty()) return;
-  auto loaded = SvgParser::load(path.toStdString());
-  if (loaded.empty()) {
-    QMessageBox::warning(
-        this, "open failed",
-        "could not parse this svg with current subset support try an svg saved by this app");
+
+  // shapes stream in from a worker thread, the first batch replaces the
+  // open document and finishLoad marks the saved state
+  cancelLoad();
+  // the opened shapes get a pool of their own, the old document's pool
+  // goes back to the heap once its shapes are dropped
+  beginShapeGeneration();
+
+  // native documents map straight into shapes, fast enough to do inline
+  // the document is only replaced once the whole file has been read
+  if (BinaryFormat::isBinaryPath(path.toStdString())) {
+    bool ok = false;
+    auto loaded = BinaryFormat::load(path.toStdString(), &ok);
+    loadingPath = path;
+    loadReplacedDocument = false;
+    appendShapes(std::move(loaded));
+    finishLoad(ok, false, 0);
     return;
   }
-  shapes.clear();
-  undoStack.clear();
-  redoStack.clear();
-  currentStateId = 0;
-  nextStateId = 1;
-  setSelectedShape(nullptr);
-  shapes = std::move(loaded);
-  currentFilePath = path;
-
-  // update saved snapshot after loading new file
-  savedXml = computeDocumentXml();
-  syncModifiedState();
-  update();
+  CreationDefaults d = getCreationDefaults();
+  startLoad(path, d.simplifyOnImport ? d.simplifyTolerance : 0.0);
 }
 
 // create new blank document with unsaved changes prompt
 void Canvas::newFile() {
+  cancelLoad();
   if (dirty) {
     auto choice = promptUnsavedChanges(
         this, "You have unsaved changes. Save before creating a new file?");
     if (choice == UnsavedChoice::Cancel) return;
     if (choice == UnsavedChoice::Save) save();
   }
-  shapes.clear();
+  waitForSave();
+  setShapes({});
   undoStack.clear();
   redoStack.clear();
-  currentStateId = 0;
   nextStateId = 1;
   setSelectedShape(nullptr);
   previewShape = nullptr;
   clipboard = nullptr;
   currentFilePath.clear();
-  savedXml = computeDocumentXml();
+  // with the document, history and clipboard gone the pool is usually idle
+  releaseShapeMemory();
+  enterState(0);
+  savedStateId = 0;
+  journal.start("");
   syncModifiedState();
-  update();
 }
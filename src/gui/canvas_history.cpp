@@ -5,6 +5,7 @@
 
 // push a command onto undo stack and clear redo stack
 // called for every user action that changes document state
+// each history step also appends its edits to the crash journal
 void Canvas::pushCommand(std::unique_ptr<Command> cmd) {
   if (historyReplayInProgress) return;
   HistoryEntry entry;
@@ -13,12 +14,17 @@ void Canvas::pushCommand(std::unique_ptr<Command> cmd) {
   entry.nextStateId = nextStateId++;
   undoStack.push_back(std::move(entry));
   redoStack.clear();
-  currentStateId = undoStack.back().nextStateId;
+  enterState(undoStack.back().nextStateId);
+  journal.commit(shapes);
   syncModifiedState();
 }
 
-// modified state tracking based on comparing current document XML with saved
-// snapshot
+void Canvas::settleEdits() {
+  stateRevision = documentRevision;
+  syncModifiedState();
+}
+
+// modified state tracking based on history state ids, see syncModifiedState
 bool Canvas::isModified() const { return dirty; }
 QString Canvas::getFilePath() const { return currentFilePath; }
 bool Canvas::isHistoryReplayInProgress() const {
@@ -29,43 +35,42 @@ bool Canvas::isHistoryReplayInProgress() const {
 // toggle replay flag to avoid recording undo/redo commands during history
 // replay
 void Canvas::undo() {
-  if (undoStack.empty()) return;
+  if (undoStack.empty() || isLoading()) return;
   auto entry = std::move(undoStack.back());
   undoStack.pop_back();
   historyReplayInProgress = true;
   entry.command->undo(this);
   historyReplayInProgress = false;
-  currentStateId = entry.prevStateId;
+  enterState(entry.prevStateId);
   redoStack.push_back(std::move(entry));
+  journal.commit(shapes);
   syncModifiedState();
 }
 
 // similar to undo above but in reverse direction
 void Canvas::redo() {
-  if (redoStack.empty()) return;
+  if (redoStack.empty() || isLoading()) return;
   auto entry = std::move(redoStack.back());
   redoStack.pop_back();
   historyReplayInProgress = true;
   entry.command->redo(this);
   historyReplayInProgress = false;
-  currentStateId = entry.nextStateId;
+  enterState(entry.nextStateId);
   undoStack.push_back(std::move(entry));
+  journal.commit(shapes);
   syncModifiedState();
 }
 
-// serialize current shape list into comparable xml text
-// used to check whether document is modified compared to last saved state
-QString Canvas::computeDocumentXml() const {
-  QString data;
-  data.reserve(shapes.size() * 32);
-  for (const auto& s : shapes) data += QString::fromStdString(s->toSVG());
-  return data;
+void Canvas::enterState(int stateId) {
+  currentStateId = stateId;
+  stateRevision = documentRevision;
 }
 
-// compare current xml with saved xml and emit signal on change
+// constant time check: away from the saved history state, or holding edits
+// made since the last history step
 void Canvas::syncModifiedState() {
-  QString cur = computeDocumentXml();
-  bool modifiedNow = (cur != savedXml);
+  bool modifiedNow = currentStateId != savedStateId ||
+                     documentRevision != stateRevision;
   if (dirty == modifiedNow) return;
   dirty = modifiedNow;
   emit modifiedChanged();
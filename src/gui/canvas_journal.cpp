@@ -0,0 +1,38 @@
+// canvas_journal.cpp
+// recovers the document of a crashed session from its journal
+
+#include <QMessageBox>
+
+#include "gui/canvas.h"
+
+// the newest leftover journal is offered, declining removes it
+// a recovered document keeps its file path and counts as modified
+void Canvas::startJournal() {
+  auto leftovers = DocumentJournal::leftovers();
+  if (!leftovers.empty()) {
+    auto choice = QMessageBox::question(
+        this, "recover document",
+        "the editor did not close cleanly, recover the unsaved changes?");
+    std::string basePath;
+    ShapeStore recovered;
+    if (choice == QMessageBox::Yes &&
+        DocumentJournal::replay(leftovers.front(), basePath, recovered)) {
+      setShapes(std::move(recovered));
+      // should another instance have claimed the journal meanwhile, the
+      // recovered shapes go into a journal of their own
+      if (!journal.resume(leftovers.front())) {
+        journal.start("");
+        for (auto it = shapes.begin(); it != shapes.end(); ++it)
+          journal.shapeAdded(*it, it.z());
+        journal.commit(shapes);
+      }
+      currentFilePath = QString::fromStdString(basePath);
+      enterState(0);
+      savedStateId = -1;
+      syncModifiedState();
+      return;
+    }
+    DocumentJournal::remove(leftovers.front());
+  }
+  journal.start("");
+}
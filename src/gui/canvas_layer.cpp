@@ -0,0 +1,77 @@
+// canvas_layer.cpp
+// cached raster of the shapes that stay still during an interactive drag
+
+#include <QPainter>
+#include <cmath>
+#include <iterator>
+
+#include "gui/canvas.h"
+
+namespace {
+using ShapeIter = ShapeStore::const_iterator;
+
+// draw a range of shapes into a fresh image of the widget's pixel size
+QImage renderLayer(ShapeIter first, ShapeIter last, QSize pixels, double dpr,
+                   Qt::GlobalColor background) {
+  QImage image(pixels, QImage::Format_ARGB32_Premultiplied);
+  image.setDevicePixelRatio(dpr);
+  image.fill(background);
+  QPainter painter(&image);
+  painter.setRenderHint(QPainter::Antialiasing);
+  for (auto it = first; it != last; ++it) (*it)->draw(painter);
+  return image;
+}
+}  // namespace
+
+// pixel size the layer images need for the current widget size and screen
+QSize Canvas::layerPixelSize() const {
+  double dpr = devicePixelRatioF();
+  return QSize(static_cast<int>(std::ceil(width() * dpr)),
+               static_cast<int>(std::ceil(height() * dpr)));
+}
+
+// render every shape except the active one, split around it so the dragged
+// shape keeps its place in the z order when frames are composited
+void Canvas::beginStaticLayer(const std::shared_ptr<GraphicsObject>& active) {
+  dropStaticLayer();
+  if (width() <= 0 || height() <= 0) return;
+  double dpr = devicePixelRatioF();
+  QSize pixels = layerPixelSize();
+
+  auto split = shapes.find(active.get());
+  staticLayer.below =
+      renderLayer(shapes.begin(), split, pixels, dpr, Qt::white);
+  if (split != shapes.end() && std::next(split) != shapes.end())
+    staticLayer.above = renderLayer(std::next(split), shapes.end(), pixels,
+                                    dpr, Qt::transparent);
+  staticLayer.active = split != shapes.end() ? active : nullptr;
+  staticLayer.valid = true;
+}
+
+// throw the cached images away, the next frame paints shapes directly again
+void Canvas::dropStaticLayer() {
+  staticLayer.below = QImage();
+  staticLayer.above = QImage();
+  staticLayer.active = nullptr;
+  staticLayer.valid = false;
+}
+
+bool Canvas::hasStaticLayer() const { return staticLayer.valid; }
+
+// composite the cached layers with the live shape, false if the cache is
+// missing or no longer matches the widget
+bool Canvas::paintStaticLayer(QPainter& painter) {
+  if (!staticLayer.valid) return false;
+  if (staticLayer.below.size() != layerPixelSize()) {
+    dropStaticLayer();
+    return false;
+  }
+  painter.drawImage(QPointF(0, 0), staticLayer.below);
+  if (staticLayer.active) staticLayer.active->draw(painter);
+  if (!staticLayer.above.isNull())
+    painter.drawImage(QPointF(0, 0), staticLayer.above);
+
+  paintStats.drawn = staticLayer.active ? 1 : 0;
+  paintStats.culled = shapes.size() - paintStats.drawn;
+  return true;
+}
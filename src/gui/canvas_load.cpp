@@ -0,0 +1,135 @@
+// canvas_load.cpp
+// background svg open that streams shapes into the canvas as they parse
+
+#include <QCoreApplication>
+#include <QMessageBox>
+#include <QThread>
+
+#include "gui/canvas.h"
+#include "gui/svg_load_worker.h"
+#include "shapes/shape_pool.h"
+
+bool Canvas::isLoading() const { return loadWorker != nullptr; }
+
+// start the worker thread, the open document stays until shapes arrive
+void Canvas::startLoad(const QString& path, double simplifyTolerance) {
+  loadingPath = path;
+  loadReplacedDocument = false;
+  loadContext = new QObject(this);
+  loadThread = new QThread(this);
+  loadWorker = new SvgLoadWorker(path, simplifyTolerance);
+  loadWorker->moveToThread(loadThread);
+
+  connect(loadThread, &QThread::started, loadWorker, &SvgLoadWorker::run);
+  connect(loadWorker, &SvgLoadWorker::batchReady, loadContext,
+          [this](ShapeBatch batch) { appendShapes(std::move(batch)); });
+  connect(loadWorker, &SvgLoadWorker::progress, loadContext,
+          [this](int percent) { emit loadProgress(percent); });
+  connect(loadWorker, &SvgLoadWorker::finished, loadContext,
+          [this](bool ok, bool cancelled, size_t removed) {
+            finishLoad(ok, cancelled, removed);
+          });
+
+  // edits wait while shapes stream in, selecting and inspecting stay live
+  emit loadStateChanged(true);
+  emit loadProgress(0);
+  loadThread->start();
+}
+
+// the loaded file takes over from the open document and its history
+// called once the first shapes arrived, so a failed open changes nothing
+void Canvas::replaceDocumentForLoad() {
+  if (loadReplacedDocument) return;
+  loadReplacedDocument = true;
+  waitForSave();
+  undoStack.clear();
+  redoStack.clear();
+  nextStateId = 1;
+  setSelectedShape(nullptr);
+  setShapes({});
+  currentFilePath.clear();
+}
+
+// add a parsed batch on top of the shapes loaded so far
+void Canvas::appendShapes(std::vector<std::shared_ptr<GraphicsObject>> batch) {
+  if (batch.empty()) return;
+  replaceDocumentForLoad();
+  dropStaticLayer();
+  documentRevision++;
+  for (auto& shape : batch) {
+    shapes.insertTop(shape);
+    ShapeStore::ZKey z = shapes.zOf(shape.get());
+    shapeIndex.insert(shape, z);
+    columns.insert(shape, z);
+  }
+  update();
+}
+
+// join the worker after it returned from run(), then drop any signal of it
+// still waiting in the event queue
+// this can run inside a slot of loadContext, so the context is only
+// deleted later
+void Canvas::stopLoadThread() {
+  if (!loadWorker) return;
+  loadWorker->cancel();
+  loadThread->quit();
+  loadThread->wait();
+  delete loadWorker;
+  delete loadThread;
+  QCoreApplication::removePostedEvents(loadContext);
+  loadContext->deleteLater();
+  loadWorker = nullptr;
+  loadThread = nullptr;
+  loadContext = nullptr;
+}
+
+// stop a running load and keep what was parsed so far as an unsaved document
+void Canvas::cancelLoad() {
+  if (!loadWorker) return;
+  stopLoadThread();
+  finishLoad(true, true, 0);
+}
+
+// the loaded file becomes the saved state, a cancelled or partly read load
+// stays untitled and counts as modified
+// a failed or cancelled load with no shapes leaves the open document
+// exactly as it was, a valid file without shapes opens as an empty document
+void Canvas::finishLoad(bool ok, bool cancelled, size_t removedPoints) {
+  stopLoadThread();
+  emit loadStateChanged(false);
+  if (!loadReplacedDocument && (cancelled || !ok)) {
+    if (!cancelled) {
+      QMessageBox::warning(
+          this, "open failed",
+          "could not read this file, svg support covers the subset this app "
+          "writes");
+    }
+    releaseShapeMemory();
+    return;
+  }
+  replaceDocumentForLoad();
+  loadReplacedDocument = false;
+  bool complete = ok && !cancelled;
+  currentFilePath = complete ? loadingPath : QString();
+
+  // the journal starts from the loaded file, a partial document has no file
+  // to start from so its shapes go into the journal
+  journal.start(currentFilePath.toStdString());
+  if (!complete) {
+    for (auto it = shapes.begin(); it != shapes.end(); ++it)
+      journal.shapeAdded(*it, it.z());
+    journal.commit(shapes);
+  }
+  enterState(0);
+  savedStateId = complete ? 0 : -1;
+  syncModifiedState();
+  if (!ok && !cancelled) {
+    QMessageBox::warning(
+        this, "open incomplete",
+        "parts of this file could not be read, the rest opened as an "
+        "untitled document so saving does not overwrite the file");
+  }
+  if (removedPoints > 0) emit strokeSimplified(removedPoints);
+  // the worker is gone and the old document dropped, a quiet point
+  releaseShapeMemory();
+}
@@ -1,30 +1,29 @@
 // canvas_paint.cpp
 // paint event implementation for canvas
 
+#include <QPaintEvent>
 #include <QPainter>
-#include <QPainterPath>
 #include <cmath>
+#include <type_traits>
 
 #include "gui/canvas.h"
-#include "shapes/freehand.h"
-#include "shapes/hexagon.h"
-#include "shapes/line.h"
-#include "shapes/rounded_rectangle.h"
-#include "shapes/text_shape.h"
+#include "shapes/shape_visit.h"
 #include "tools/handle_helpers.h"
 
-// paint event draws all shapes and selection handles
+// paint event draws the shapes meeting the exposed area and selection handles
 // also draws preview shape with dashed outline if needed
-void Canvas::paintEvent(QPaintEvent*) {
+void Canvas::paintEvent(QPaintEvent* event) {
   QPainter painter(this);
-  painter.fillRect(rect(), Qt::white);
+  painter.setClipRect(event->rect());
+  painter.fillRect(event->rect(), Qt::white);
   painter.setRenderHint(QPainter::Antialiasing);
-  for (const auto& shape : shapes) {
-    if (textEditing) {
-      auto txt = std::dynamic_pointer_cast<TextShape>(shape);
-      if (txt && selectedShape && shape == selectedShape) continue;
-    }
-    shape->draw(painter);
+
+  // during a drag the still shapes come from the cached layer, otherwise
+  // only shapes surviving the culling stage are drawn, back to front
+  if (!paintStaticLayer(painter)) {
+    std::vector<std::shared_ptr<GraphicsObject>> visible;
+    cullShapes(event->region(), visible);
+    for (const auto& shape : visible) shape->draw(painter);
   }
 
   if (previewShape) {
@@ -34,44 +33,37 @@ void Canvas::paintEvent(QPaintEvent*) {
     painter.setBrush(Qt::NoBrush);
     QRectF box = previewShape->boundingBox();
 
-    // draw preview shape based on current mode with correct geometry
-    if (getMode() == ShapeMode::CIRCLE) {
-      painter.drawEllipse(box);
-
-    } else if (getMode() == ShapeMode::HEXAGON) {
-      auto* hex = dynamic_cast<Hexagon*>(previewShape.get());
-      QPolygonF poly;
-      double cx = box.center().x(), cy = box.center().y();
-      double rx = box.width() / 2.0, ry = box.height() / 2.0;
-      double offset =
-
-          (hex && hex->isPointyTop()) ? (3.14159265358979 / 6.0) : 0.0;
-      for (int i = 0; i < 6; i++) {
-        double a = 3.14159265358979 / 180.0 * (60.0 * i) + offset;
-        poly << QPointF(cx + rx * std::cos(a), cy + ry * std::sin(a));
-      }
-      painter.drawPolygon(poly);
-    } else if (getMode() == ShapeMode::LINE) {
-      auto* line = dynamic_cast<Line*>(previewShape.get());
-      if (line)
-        painter.drawLine(QPointF(line->getX1(), line->getY1()),
-                         QPointF(line->getX2(), line->getY2()));
-    } else if (getMode() == ShapeMode::FREEHAND) {
-      auto* fh = dynamic_cast<Freehand*>(previewShape.get());
-      if (fh && fh->getPoints().size() >= 2) {
-        const auto& pts = fh->getPoints();
-        QPainterPath path;
-        path.moveTo(pts[0]);
-        for (size_t i = 1; i < pts.size(); i++) path.lineTo(pts[i]);
-        painter.drawPath(path);
+    // draw preview shape by class with its own geometry
+    visitShape(*previewShape, [&](auto& shape) {
+      using T = std::decay_t<decltype(shape)>;
+      if constexpr (std::is_same_v<T, Circle>) {
+        painter.drawEllipse(box);
+      } else if constexpr (std::is_same_v<T, Hexagon>) {
+        QPolygonF poly;
+        double cx = box.center().x(), cy = box.center().y();
+        double rx = box.width() / 2.0, ry = box.height() / 2.0;
+        double offset = shape.isPointyTop() ? (3.14159265358979 / 6.0) : 0.0;
+        for (int i = 0; i < 6; i++) {
+          double a = 3.14159265358979 / 180.0 * (60.0 * i) + offset;
+          poly << QPointF(cx + rx * std::cos(a), cy + ry * std::sin(a));
+        }
+        painter.drawPolygon(poly);
+      } else if constexpr (std::is_same_v<T, Line>) {
+        painter.drawLine(QPointF(shape.getX1(), shape.getY1()),
+                         QPointF(shape.getX2(), shape.getY2()));
+      } else if constexpr (std::is_same_v<T, Freehand>) {
+        // the stroke's own cached path, extended once per sample
+        if (shape.getPoints().size() >= 2) painter.drawPath(shape.getPath());
+      } else if constexpr (std::is_same_v<T, RoundedRectangle>) {
+        double r = shape.getCornerRadius();
+        painter.drawRoundedRect(box, r, r);
+      } else if constexpr (std::is_same_v<T, Rectangle> ||
+                           std::is_same_v<T, TextShape>) {
+        painter.drawRect(box);
+      } else {
+        static_assert(alwaysFalse<T>, "the preview does not handle this shape");
       }
-    } else if (getMode() == ShapeMode::ROUNDED_RECT) {
-      auto* rr = dynamic_cast<RoundedRectangle*>(previewShape.get());
-      double r = rr ? rr->getCornerRadius() : 10.0;
-      painter.drawRoundedRect(box, r, r);
-    } else {
-      painter.drawRect(box);
-    }
+    });
   }
 
   // draw selection handles if a shape is selected and not currently editing
@@ -0,0 +1,82 @@
+// canvas_save.cpp
+// saves a snapshot of the document on a worker thread while editing goes on
+
+#include <QCoreApplication>
+#include <QMessageBox>
+#include <QThread>
+
+#include "gui/canvas.h"
+#include "gui/svg_save_worker.h"
+
+bool Canvas::isSaving() const { return saveWorker != nullptr; }
+
+// the worker shares the live shapes, aboutToChange copies one only when it
+// is edited before the worker wrote it
+// the title keeps its modified mark until the write commits
+void Canvas::save() {
+  if (currentFilePath.isEmpty()) {
+    saveAs();
+    return;
+  }
+  if (isLoading()) return;
+  waitForSave();
+
+  saveSnapshot = std::make_shared<SaveSnapshot>(
+      std::vector<std::shared_ptr<GraphicsObject>>(shapes.begin(),
+                                                   shapes.end()));
+  saveStateId = currentStateId;
+  saveRevision = documentRevision;
+  journal.markSnapshot(shapes);
+
+  saveContext = new QObject(this);
+  saveThread = new QThread(this);
+  saveWorker =
+      new SvgSaveWorker(currentFilePath, width(), height(), saveSnapshot);
+  saveWorker->moveToThread(saveThread);
+  connect(saveThread, &QThread::started, saveWorker, &SvgSaveWorker::run);
+  connect(saveWorker, &SvgSaveWorker::finished, saveContext,
+          [this]() { finishSave(); });
+  saveThread->start();
+}
+
+void Canvas::aboutToChange(const std::shared_ptr<GraphicsObject>& shape) {
+  if (saveSnapshot && shape) saveSnapshot->aboutToChange(shape.get());
+}
+
+void Canvas::waitForSave() {
+  if (saveWorker) finishSave();
+}
+
+// join the worker and drop it along with its queued finished signal
+// this can run inside the slot of saveContext, so the context is only
+// deleted later
+bool Canvas::joinSaveThread() {
+  saveThread->quit();
+  saveThread->wait();
+  bool ok = saveWorker->succeeded();
+  delete saveWorker;
+  delete saveThread;
+  QCoreApplication::removePostedEvents(saveContext);
+  saveContext->deleteLater();
+  saveWorker = nullptr;
+  saveThread = nullptr;
+  saveContext = nullptr;
+  // copies made for the save go with it
+  saveSnapshot = nullptr;
+  return ok;
+}
+
+// the snapshot state becomes the saved one, edits made since keep the
+// document modified
+void Canvas::finishSave() {
+  if (!joinSaveThread()) {
+    QMessageBox::warning(this, "save failed",
+                         "could not write " + currentFilePath);
+    return;
+  }
+  journal.snapshotSaved(currentFilePath.toStdString());
+  savedStateId = saveStateId;
+  if (currentStateId == saveStateId && documentRevision == saveRevision)
+    enterState(currentStateId);
+  syncModifiedState();
+}
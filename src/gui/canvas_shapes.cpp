@@ -0,0 +1,119 @@
+// canvas_shapes.cpp
+// document shape list mutations, hit testing and repaint regions
+
+#include "gui/canvas.h"
+#include "tools/handle_helpers.h"
+
+// read only view of the document, back to front
+const ShapeStore& Canvas::getShapes() const { return shapes; }
+
+// append a shape on top of the z order
+void Canvas::addShape(std::shared_ptr<GraphicsObject> shape) {
+  insertShape(std::move(shape), 0);
+}
+
+// put a shape at a z key, a key of 0 or one in use means on top
+void Canvas::insertShape(std::shared_ptr<GraphicsObject> shape,
+                         ShapeStore::ZKey z) {
+  if (!shape) return;
+  dropStaticLayer();
+  documentRevision++;
+  shapes.insertAt(shape, z);
+  z = shapes.zOf(shape.get());
+  shapeIndex.insert(shape, z);
+  columns.insert(shape, z);
+  invalidateShape(shape);
+  journal.shapeAdded(shape, z);
+}
+
+// remove the shape instance from the document, the other shapes keep their
+// keys so nothing above it has to move
+ShapeStore::ZKey Canvas::removeShape(
+    const std::shared_ptr<GraphicsObject>& shape) {
+  dropStaticLayer();
+  documentRevision++;
+  invalidateShape(shape);
+  ShapeStore::ZKey z = shapes.remove(shape.get());
+  if (z) journal.shapeRemoved(z);
+  shapeIndex.remove(shape.get());
+  columns.remove(shape.get());
+  return z;
+}
+
+// replace the whole document, used by open, new, clear and their undo
+// a saved store keeps its keys, so removals recorded before a clear still
+// undo to the right place after the clear is undone
+void Canvas::setShapes(ShapeStore newShapes) {
+  dropStaticLayer();
+  documentRevision++;
+  shapes = std::move(newShapes);
+  shapeIndex.rebuild(shapes);
+  columns.rebuild(shapes);
+  journal.shapesCleared();
+  for (auto it = shapes.begin(); it != shapes.end(); ++it)
+    journal.shapeAdded(*it, it.z());
+  update();
+}
+
+// refresh cached bounds and repaint both the old and the new area
+// only the active shape of a drag may change without dropping the layer
+void Canvas::shapeChanged(const std::shared_ptr<GraphicsObject>& shape) {
+  if (!shape) return;
+  if (shape != staticLayer.active) dropStaticLayer();
+  documentRevision++;
+  journal.shapeChanged(shape);
+  columns.update(shape.get());
+  QRectF old = shapeIndex.update(shape);
+  if (!old.isNull()) update(repaintRect(old));
+  invalidateShape(shape);
+}
+
+// schedule a repaint of the area a shape covers right now
+void Canvas::invalidateShape(const std::shared_ptr<GraphicsObject>& shape) {
+  if (shape) update(repaintRect(paintBoundsOf(shape)));
+}
+
+// repaint where the preview was and where it is now
+void Canvas::previewChanged() {
+  if (!previewBounds.isNull()) update(repaintRect(previewBounds));
+  previewBounds = previewShape ? paintBoundsOf(previewShape) : QRectF();
+  if (!previewBounds.isNull()) update(repaintRect(previewBounds));
+}
+
+// shapes outside the index (preview, removed) compute their bounds directly
+QRectF Canvas::paintBoundsOf(
+    const std::shared_ptr<GraphicsObject>& shape) const {
+  QRectF bounds = shapeIndex.paintBoundsOf(shape.get());
+  if (!bounds.isNull()) return bounds;
+  return ShapeIndex::paintBounds(shape->boundingBox().normalized(),
+                                 shape->getStrokeWidth());
+}
+
+// selection handles are centered on the box edges so pad by a full handle
+QRect Canvas::repaintRect(const QRectF& paintBounds) const {
+  return paintBounds.adjusted(-HANDLE_SIZE, -HANDLE_SIZE, HANDLE_SIZE,
+                              HANDLE_SIZE)
+      .toAlignedRect();
+}
+
+// area scans stream through the columns instead of visiting every shape
+void Canvas::shapesInRect(
+    const QRectF& area, bool contained,
+    std::vector<std::shared_ptr<GraphicsObject>>& out) const {
+  QRectF a = area.normalized();
+  if (contained)
+    columns.containedIn(a, out);
+  else
+    columns.intersecting(a, out);
+}
+
+ShapeColumns::Stats Canvas::documentStats() const { return columns.stats(); }
+
+// topmost shape under the point, the index finds the nearby shapes and the
+// columns test them in batches
+std::shared_ptr<GraphicsObject> Canvas::shapeAt(
+    QPointF p, const ShapeColumns::Filter& filter) const {
+  std::vector<const GraphicsObject*> candidates;
+  shapeIndex.candidatesAt(p, candidates);
+  return columns.topmostAt(p, candidates, filter);
+}
@@ -3,9 +3,9 @@
 // command creation for undo/redo
 
 #include <QLineEdit>
-#include <algorithm>
 
 #include "gui/canvas.h"
+#include "shapes/shape_cast.h"
 #include "shapes/text_shape.h"
 #include "tools/command.h"
 #include "tools/shape_property_command.h"
@@ -15,8 +15,12 @@
 // track whether the shape was committed or discarded
 void Canvas::finalizeTextEditing() {
   if (!textEditing) return;
-  auto txt = std::dynamic_pointer_cast<TextShape>(selectedShape);
-  if (txt && textEditor) txt->setText(textEditor->text().toStdString());
+  auto txt = shapeCast<TextShape>(selectedShape);
+  if (txt && textEditor) {
+    aboutToChange(selectedShape);
+    txt->setText(textEditor->text().toStdString());
+    shapeChanged(selectedShape);
+  }
   endTextEditing();
   if (!txt) {
     textDraftShape = nullptr;
@@ -26,9 +30,9 @@ void Canvas::finalizeTextEditing() {
   if (isDraft) {
     // empty draft text is discarded
     if (txt->getText().empty()) {
-      shapes.erase(std::remove(shapes.begin(), shapes.end(), selectedShape),
-                   shapes.end());
+      removeShape(selectedShape);
       setSelectedShape(nullptr);
+      settleEdits();
     } else {
       // committed new text is recorded as add shape action
       pushCommand(std::make_unique<AddShapeCommand>(selectedShape));
@@ -51,7 +55,8 @@ void Canvas::finalizeTextEditing() {
     if (after != before) {
       pushCommand(
           std::make_unique<ShapePropertyCommand>(selectedShape, before, after));
+    } else {
+      settleEdits();
     }
   }
-  update();
 }
@@ -0,0 +1,152 @@
+// document_journal.cpp
+// records canvas edits and appends them to the journal file per history step
+
+#include "gui/document_journal.h"
+
+#include <QDir>
+#include <QStandardPaths>
+#include <QUuid>
+#include <algorithm>
+#include <cstdio>
+
+// journals live in the app data folder, one uniquely named file per session
+std::string DocumentJournal::journalDir() {
+  QString dir =
+      QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) +
+      "/journal";
+  QDir().mkpath(dir);
+  return dir.toStdString();
+}
+
+std::string DocumentJournal::newJournalFile() {
+  return journalDir() + "/" +
+         QUuid::createUuid().toString(QUuid::WithoutBraces).toStdString() +
+         ".journal";
+}
+
+// the lock names this process, a stale time of 0 keeps it for as long as
+// the process lives however long the session runs
+bool DocumentJournal::acquire(const std::string& journalFile) {
+  lock = std::make_unique<QLockFile>(QString::fromStdString(journalFile) +
+                                     ".lock");
+  lock->setStaleLockTime(0);
+  if (!lock->tryLock(0)) {
+    lock.reset();
+    return false;
+  }
+  filePath = journalFile;
+  return true;
+}
+
+// keys counting up from 1 are what replay assigns anyway and are left out
+std::string DocumentJournal::keyList(
+    const std::vector<ShapeStore::ZKey>& keys) {
+  std::string list;
+  bool counted = true;
+  for (size_t i = 0; i < keys.size() && counted; i++)
+    counted = keys[i] == i + 1;
+  if (counted) return list;
+  for (ShapeStore::ZKey z : keys) list += " " + std::to_string(z);
+  return list;
+}
+
+void DocumentJournal::writeHeader(const std::string& basePath,
+                                  const std::vector<ShapeStore::ZKey>& keys) {
+  file << "J " << basePath << '\n';
+  std::string print = basePath.empty() ? "" : fingerprint(basePath);
+  if (!print.empty()) file << "F " << print << '\n';
+  std::string list = keyList(keys);
+  if (!list.empty()) file << "K" << list << '\n';
+  file.flush();
+}
+
+void DocumentJournal::start(const std::string& basePath) {
+  discard();
+  if (!acquire(newJournalFile())) return;
+  file.open(filePath, std::ios::binary | std::ios::trunc);
+  writeHeader(basePath);
+}
+
+bool DocumentJournal::resume(const std::string& journalFile) {
+  discard();
+  if (!acquire(journalFile)) return false;
+  file.open(filePath, std::ios::binary | std::ios::app);
+  file << '\n';  // ends a line torn by the crash, empty lines are skipped
+  file.flush();
+  return true;
+}
+
+void DocumentJournal::discard() {
+  pending.clear();
+  changed.clear();
+  snapshotOffset = -1;
+  snapshotKeys.clear();
+  if (filePath.empty()) return;
+  file.close();
+  std::remove(filePath.c_str());
+  filePath.clear();
+  lock.reset();  // unlocks and removes the lock file
+}
+
+void DocumentJournal::shapeAdded(const std::shared_ptr<GraphicsObject>& shape,
+                                 ShapeStore::ZKey z) {
+  if (!filePath.empty()) pending.push_back({'A', shape, z});
+}
+
+void DocumentJournal::shapeRemoved(ShapeStore::ZKey z) {
+  if (!filePath.empty()) pending.push_back({'R', nullptr, z});
+}
+
+// a clear supersedes everything recorded before it in the same step
+void DocumentJournal::shapesCleared() {
+  if (filePath.empty()) return;
+  pending.clear();
+  changed.clear();
+  pending.push_back({'C', nullptr, 0});
+}
+
+void DocumentJournal::shapeChanged(
+    const std::shared_ptr<GraphicsObject>& shape) {
+  if (filePath.empty()) return;
+  if (std::find(changed.begin(), changed.end(), shape) == changed.end())
+    changed.push_back(shape);
+}
+
+// markup is kept on one line so a torn last line is easy to spot on replay
+void DocumentJournal::appendShape(std::string& line,
+                                  const GraphicsObject& shape) {
+  scratch.clear();
+  shape.writeSVG(scratch);
+  size_t start = line.size();
+  line += scratch.data();
+  std::replace(line.begin() + start, line.end(), '\n', ' ');
+}
+
+// edited shapes are written last at their final key, after the
+// structural records of the step have been replayed
+void DocumentJournal::commit(const ShapeStore& shapes) {
+  std::string out;
+  for (const auto& op : pending) {
+    if (op.type == 'A') {
+      out += "A " + std::to_string(op.z) + " ";
+      appendShape(out, *op.shape);
+    } else if (op.type == 'R') {
+      out += "R " + std::to_string(op.z);
+    } else {
+      out += op.type;
+    }
+    out += '\n';
+  }
+  for (const auto& shape : changed) {
+    ShapeStore::ZKey z = shapes.zOf(shape.get());
+    if (z == 0) continue;
+    out += "P " + std::to_string(z) + " ";
+    appendShape(out, *shape);
+    out += '\n';
+  }
+  pending.clear();
+  changed.clear();
+  if (filePath.empty() || out.empty()) return;
+  file.write(out.data(), static_cast<std::streamsize>(out.size()));
+  file.flush();
+}
@@ -0,0 +1,199 @@
+// document_journal_replay.cpp
+// save snapshots, leftover journal lookup and replay after a crash
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <cstdio>
+#include <filesystem>
+#include <iterator>
+
+#include "gui/document_journal.h"
+#include "parse/mapped_file.h"
+#include "parse/binary_reader.h"
+#include "parse/svg_parser.h"
+#include "shapes/binary_format.h"
+
+// flush the step in progress so the mark sits exactly at the snapshot
+// the keys of the saved shapes go into the header of the restarted journal
+void DocumentJournal::markSnapshot(const ShapeStore& shapes) {
+  commit(shapes);
+  if (filePath.empty()) return;
+  snapshotKeys.clear();
+  snapshotKeys.reserve(shapes.size());
+  for (auto it = shapes.begin(); it != shapes.end(); ++it)
+    snapshotKeys.push_back(it.z());
+  snapshotOffset = file.tellp();
+  file << "S" << keyList(snapshotKeys) << '\n';
+  file.flush();
+}
+
+// the journal restarts from the saved file with the records after the mark,
+// written beside it first and renamed so a crash keeps one complete journal
+void DocumentJournal::snapshotSaved(const std::string& path) {
+  if (filePath.empty() || snapshotOffset < 0) return;
+  std::string tail;
+  {
+    std::ifstream in(filePath, std::ios::binary);
+    in.seekg(snapshotOffset);
+    tail.assign(std::istreambuf_iterator<char>(in),
+                std::istreambuf_iterator<char>());
+  }
+  tail.erase(0, tail.find('\n') + 1);  // the S line itself
+
+  file.close();
+  std::string temp = filePath + ".tmp";
+  file.open(temp, std::ios::binary | std::ios::trunc);
+  writeHeader(path, snapshotKeys);
+  file << tail;
+  file.close();
+  std::rename(temp.c_str(), filePath.c_str());
+  file.open(filePath, std::ios::binary | std::ios::app);
+  snapshotOffset = -1;
+  snapshotKeys.clear();
+}
+
+// eight bytes at a time through a multiply and rotate mix, fast enough to
+// run over a large document on every save
+std::string DocumentJournal::fingerprint(const std::string& path) {
+  MappedFile mapped(path);
+  if (!mapped.isOpen()) return "";
+  std::string_view bytes = mapped.data();
+  const uint64_t kMul = 0x9e3779b97f4a7c15ull;
+  uint64_t hash = bytes.size() * kMul;
+  size_t i = 0;
+  for (; i + 8 <= bytes.size(); i += 8) {
+    uint64_t word;
+    std::memcpy(&word, bytes.data() + i, 8);
+    hash = ((hash ^ word) * kMul);
+    hash ^= hash >> 29;
+  }
+  for (; i < bytes.size(); i++)
+    hash = (hash ^ static_cast<unsigned char>(bytes[i])) * kMul;
+  return std::to_string(bytes.size()) + " " + std::to_string(hash);
+}
+
+namespace {
+// keys of a K line, empty when one does not parse
+std::vector<ShapeStore::ZKey> parseKeys(std::string_view text) {
+  std::vector<ShapeStore::ZKey> keys;
+  const char* at = text.data();
+  const char* end = text.data() + text.size();
+  while (at < end) {
+    if (*at == ' ') {
+      at++;
+      continue;
+    }
+    ShapeStore::ZKey z = 0;
+    auto res = std::from_chars(at, end, z);
+    if (res.ec != std::errc() || z == 0) return {};
+    keys.push_back(z);
+    at = res.ptr;
+  }
+  return keys;
+}
+
+// true when the journal holds at least one edit after its header
+bool hasRecords(const std::string& journalFile) {
+  std::ifstream in(journalFile, std::ios::binary);
+  std::string line;
+  if (!std::getline(in, line)) return false;
+  while (std::getline(in, line))
+    if (!line.empty() && line[0] != 'F' && line[0] != 'K' && line[0] != 'S')
+      return true;
+  return false;
+}
+}  // namespace
+
+// a lock that can be taken belongs to a session that is gone, journals of
+// running sessions keep theirs and are skipped
+std::vector<std::string> DocumentJournal::leftovers() {
+  namespace fs = std::filesystem;
+  std::vector<fs::directory_entry> found;
+  std::error_code ec;
+  for (const auto& entry : fs::directory_iterator(journalDir(), ec)) {
+    if (entry.path().extension() != ".journal") continue;
+    std::string path = entry.path().string();
+    QLockFile probe(QString::fromStdString(path) + ".lock");
+    probe.setStaleLockTime(0);
+    if (!probe.tryLock(0)) continue;
+    if (hasRecords(path))
+      found.push_back(entry);
+    else
+      std::remove(path.c_str());
+  }
+  std::sort(found.begin(), found.end(), [](const auto& a, const auto& b) {
+    return a.last_write_time() > b.last_write_time();
+  });
+  std::vector<std::string> paths;
+  for (const auto& entry : found) paths.push_back(entry.path().string());
+  return paths;
+}
+
+void DocumentJournal::remove(const std::string& journalFile) {
+  QLockFile probe(QString::fromStdString(journalFile) + ".lock");
+  probe.setStaleLockTime(0);
+  if (probe.tryLock(0)) std::remove(journalFile.c_str());
+}
+
+// a last line without its newline was torn by the crash and is skipped
+// a base file that no longer matches its fingerprint was replaced by a save
+// that committed before the journal restarted, the records up to the last
+// snapshot mark are already in it so replay starts at the mark
+bool DocumentJournal::replay(const std::string& journalFile,
+                             std::string& basePath, ShapeStore& shapes) {
+  std::ifstream in(journalFile, std::ios::binary);
+  std::string line;
+  if (!std::getline(in, line) || line.compare(0, 2, "J ") != 0) return false;
+  basePath = line.substr(2);
+  std::streamoff records = in.tellg();
+  std::string recorded;
+  std::streamoff lastSnapshot = -1;
+  for (std::streamoff at = records; std::getline(in, line) && !in.eof();
+       at = in.tellg()) {
+    if (line.compare(0, 2, "F ") == 0)
+      recorded = line.substr(2);
+    else if (!line.empty() && line[0] == 'S')
+      lastSnapshot = at;
+  }
+  bool rebased = !recorded.empty() && lastSnapshot >= 0 &&
+                 fingerprint(basePath) != recorded;
+
+  if (BinaryFormat::isBinaryPath(basePath))
+    shapes.assign(BinaryFormat::load(basePath));
+  else if (!basePath.empty())
+    shapes.assign(SvgParser::load(basePath));
+  else
+    shapes.clear();
+
+  in.clear();
+  in.seekg(rebased ? lastSnapshot : records);
+  while (std::getline(in, line) && !in.eof()) {
+    if (line.empty()) continue;
+    std::string_view rest = std::string_view(line).substr(1);
+    if (!rest.empty()) rest.remove_prefix(1);
+    ShapeStore::ZKey z = 0;
+    if (line[0] == 'A' || line[0] == 'R' || line[0] == 'P') {
+      auto res = std::from_chars(rest.data(), rest.data() + rest.size(), z);
+      if (res.ec != std::errc() || z == 0) continue;
+      rest.remove_prefix(res.ptr - rest.data());
+    }
+    if (line[0] == 'A') {
+      auto parsed = SvgParser::parse(rest);
+      if (parsed.size() == 1) shapes.insertAt(parsed.front(), z);
+    } else if (line[0] == 'R') {
+      shapes.removeAt(z);
+    } else if (line[0] == 'P') {
+      auto parsed = SvgParser::parse(rest);
+      if (parsed.size() == 1 && shapes.removeAt(z))
+        shapes.insertAt(parsed.front(), z);
+    } else if (line[0] == 'C') {
+      shapes.clear();
+    } else if (line[0] == 'K' || (line[0] == 'S' && rebased)) {
+      // the base shapes take the keys they had in the session that saved
+      std::vector<ShapeStore::ShapePtr> base(shapes.begin(), shapes.end());
+      shapes.assign(base, parseKeys(rest));
+    }
+  }
+  return true;
+}
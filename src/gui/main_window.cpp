@@ -5,6 +5,9 @@
 
 #include <QFileInfo>
 #include <QHBoxLayout>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QStatusBar>
 #include <QVBoxLayout>
 
 #include "gui/canvas.h"
@@ -41,10 +44,26 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
   resize(1200, 700);
   createMenus();
 
+  // open progress lives in the status bar and stays hidden when idle
+  loadBar = new QProgressBar(this);
+  loadBar->setRange(0, 100);
+  loadBar->setFixedWidth(160);
+  cancelLoadButton = new QPushButton("Cancel", this);
+  statusBar()->addPermanentWidget(loadBar);
+  statusBar()->addPermanentWidget(cancelLoadButton);
+  showLoadState(false);
+
   connect(canvas, &Canvas::selectionChanged, panel,
           &PropertiesPanel::refreshFromSelection);
   connect(canvas, &Canvas::modifiedChanged, this,
           &MainWindow::updateWindowTitle);
+  connect(canvas, &Canvas::strokeSimplified, this,
+          &MainWindow::showSimplified);
+  connect(canvas, &Canvas::loadStateChanged, this,
+          &MainWindow::showLoadState);
+  connect(canvas, &Canvas::loadProgress, loadBar, &QProgressBar::setValue);
+  connect(cancelLoadButton, &QPushButton::clicked, canvas,
+          &Canvas::cancelLoad);
 }
 
 // expose canvas pointer for tests and integration points
@@ -72,3 +91,19 @@ void MainWindow::updateWindowTitle() {
   if (canvas->isModified()) title += " *";
   setWindowTitle(title);
 }
+
+// report how many freehand points simplification dropped
+void MainWindow::showSimplified(size_t removedPoints) {
+  statusBar()->showMessage(
+      QString("Stroke simplification removed %1 points")
+          .arg(static_cast<qulonglong>(removedPoints)),
+      4000);
+}
+
+void MainWindow::showLoadState(bool loading) {
+  loadBar->setValue(0);
+  loadBar->setVisible(loading);
+  cancelLoadButton->setVisible(loading);
+  // the panel keeps showing the selection but cannot edit it mid load
+  panel->setEnabled(!loading);
+}
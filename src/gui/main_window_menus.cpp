@@ -2,10 +2,12 @@
 // implementation for main window menus to build menu structure and connect
 // actions to canvas slots
 
+#include <QInputDialog>
 #include <QMenuBar>
 
 #include "gui/canvas.h"
 #include "gui/main_window.h"
+#include "tools/shape_style_defaults.h"
 
 // build file and edit menus and connect actions to canvas slots
 void MainWindow::createMenus() {
@@ -61,4 +63,37 @@ void MainWindow::createMenus() {
 
   QAction* clearAction = editMenu->addAction("Clear All");
   connect(clearAction, &QAction::triggered, canvas, &Canvas::clearAll);
+  editMenu->addSeparator();
+
+  // freehand simplification settings
+  QAction* toleranceAction = editMenu->addAction("Stroke Simplification...");
+  connect(toleranceAction, &QAction::triggered, this,
+          &MainWindow::editSimplifyTolerance);
+
+  QAction* importAction = editMenu->addAction("Simplify Strokes On Open");
+  importAction->setCheckable(true);
+  importAction->setChecked(getCreationDefaults().simplifyOnImport);
+  connect(importAction, &QAction::toggled, this, [](bool on) {
+    auto d = getCreationDefaults();
+    d.simplifyOnImport = on;
+    setCreationDefaults(d);
+  });
+  editMenu->addSeparator();
+
+  QAction* statsAction = editMenu->addAction("Document Statistics...");
+  connect(statsAction, &QAction::triggered, this,
+          &MainWindow::showDocumentStats);
+}
+
+// ask for the freehand simplification tolerance in pixels, zero disables it
+void MainWindow::editSimplifyTolerance() {
+  auto d = getCreationDefaults();
+  bool ok = false;
+  double tol = QInputDialog::getDouble(
+      this, "Stroke Simplification",
+      "Tolerance in pixels (0 keeps every point)", d.simplifyTolerance, 0.0,
+      50.0, 2, &ok);
+  if (!ok) return;
+  d.simplifyTolerance = tol;
+  setCreationDefaults(d);
 }
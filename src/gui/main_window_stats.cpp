@@ -0,0 +1,33 @@
+// main_window_stats.cpp
+// document statistics report built from whole document scans
+
+#include <QMessageBox>
+
+#include "gui/canvas.h"
+#include "gui/main_window.h"
+
+// counts per type and style plus how many shapes the visible area shows
+void MainWindow::showDocumentStats() {
+  ShapeColumns::Stats stats = canvas->documentStats();
+  std::vector<std::shared_ptr<GraphicsObject>> inView;
+  canvas->shapesInRect(QRectF(canvas->rect()), false, inView);
+
+  QString text = QString("%1 shapes, %2 in view\n")
+                     .arg(static_cast<qulonglong>(stats.shapes))
+                     .arg(static_cast<qulonglong>(inView.size()));
+  for (size_t t = 0; t < stats.byType.size(); t++) {
+    if (stats.byType[t] == 0) continue;
+    text += QString("\n%1: %2")
+                .arg(shapeTypeName(static_cast<ShapeType>(t)))
+                .arg(static_cast<qulonglong>(stats.byType[t]));
+  }
+  text += QString("\n\nfilled: %1\nstroked: %2")
+              .arg(static_cast<qulonglong>(stats.filled))
+              .arg(static_cast<qulonglong>(stats.stroked));
+  if (!stats.bounds.isNull()) {
+    text += QString("\ndrawing size: %1 x %2")
+                .arg(stats.bounds.width(), 0, 'f', 1)
+                .arg(stats.bounds.height(), 0, 'f', 1);
+  }
+  QMessageBox::information(this, "Document Statistics", text);
+}
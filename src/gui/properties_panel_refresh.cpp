@@ -22,7 +22,8 @@ void PropertiesPanel::refreshFromSelection() {
   }
 
   if (shape) {
-    bool allowAutoApply = !canvas->isHistoryReplayInProgress();
+    bool allowAutoApply =
+        !canvas->isHistoryReplayInProgress() && !canvas->isLoading();
     if (allowAutoApply) {
       // apply panel values immediately when apply on click is enabled
       auto before = captureShapeState(shape);
@@ -37,8 +38,8 @@ void PropertiesPanel::refreshFromSelection() {
       }
       if (after != before) {
         applyStateToShape(shape, after);
+        canvas->shapeChanged(shape);
         pushShapeStateCommand(shape, before, after);
-        canvas->update();
       }
     }
 
@@ -92,14 +93,11 @@ void PropertiesPanel::applyToShape() {
     after.fontSize = fontSizeSpin->value();
   }
 
-  if (before == after) {
-    canvas->update();
-    return;
-  }
+  if (before == after) return;
 
   applyStateToShape(shape, after);
+  canvas->shapeChanged(shape);
   if (!sliderInteractionActive) pushShapeStateCommand(shape, before, after);
 
   updatePreviews();
-  canvas->update();
 }
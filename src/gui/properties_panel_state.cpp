@@ -7,6 +7,7 @@
 #include "gui/properties_panel.h"
 #include "shapes/hexagon.h"
 #include "shapes/rounded_rectangle.h"
+#include "shapes/shape_cast.h"
 #include "shapes/text_shape.h"
 
 // get current shape properties into a snapshot object
@@ -18,15 +19,15 @@ ShapePropertyState PropertiesPanel::captureShapeState(
   state.strokeColor = shape->getStrokeColor();
   state.strokeWidth = shape->getStrokeWidth();
   // checks for special properties of shapes
-  if (auto rr = std::dynamic_pointer_cast<RoundedRectangle>(shape)) {
+  if (auto rr = shapeCast<RoundedRectangle>(shape)) {
     state.hasCornerRadius = true;
     state.cornerRadius = rr->getCornerRadius();
   }
-  if (auto hex = std::dynamic_pointer_cast<Hexagon>(shape)) {
+  if (auto hex = shapeCast<Hexagon>(shape)) {
     state.hasPointyTop = true;
     state.pointyTop = hex->isPointyTop();
   }
-  if (auto text = std::dynamic_pointer_cast<TextShape>(shape)) {
+  if (auto text = shapeCast<TextShape>(shape)) {
     state.hasTextStyle = true;
     state.fontFamily = text->getFontFamily();
     state.fontSize = text->getFontSize();
@@ -41,19 +42,20 @@ void PropertiesPanel::applyStateToShape(
     const std::shared_ptr<GraphicsObject>& shape,
     const ShapePropertyState& state) const {
   if (!shape) return;
+  canvas->aboutToChange(shape);
   shape->setFillColor(state.fillColor);
   shape->setStrokeColor(state.strokeColor);
   shape->setStrokeWidth(state.strokeWidth);
   if (state.hasCornerRadius) {
-    if (auto rr = std::dynamic_pointer_cast<RoundedRectangle>(shape))
+    if (auto rr = shapeCast<RoundedRectangle>(shape))
       rr->setCornerRadius(state.cornerRadius);
   }
   if (state.hasPointyTop) {
-    if (auto hex = std::dynamic_pointer_cast<Hexagon>(shape))
+    if (auto hex = shapeCast<Hexagon>(shape))
       hex->setPointyTop(state.pointyTop);
   }
   if (state.hasTextStyle) {
-    if (auto text = std::dynamic_pointer_cast<TextShape>(shape)) {
+    if (auto text = shapeCast<TextShape>(shape)) {
       text->setFontFamily(state.fontFamily);
       text->setFontSize(state.fontSize);
     }
@@ -64,7 +66,11 @@ void PropertiesPanel::applyStateToShape(
 void PropertiesPanel::pushShapeStateCommand(
     const std::shared_ptr<GraphicsObject>& shape,
     const ShapePropertyState& before, const ShapePropertyState& after) {
-  if (!shape || before == after) return;
+  if (!shape) return;
+  if (before == after) {
+    canvas->settleEdits();
+    return;
+  }
   canvas->pushCommand(
       std::make_unique<ShapePropertyCommand>(shape, before, after));
 }
@@ -0,0 +1,22 @@
+// save_snapshot.cpp
+// document shapes shared with a background save without copying them
+
+#include "gui/save_snapshot.h"
+
+SaveSnapshot::SaveSnapshot(std::vector<std::shared_ptr<GraphicsObject>> shapes)
+    : shapes(std::move(shapes)), written(this->shapes.size(), 0) {}
+
+// only the gui thread swaps slots, so reading them here needs no lock
+// a shape already written or already swapped needs no copy
+void SaveSnapshot::aboutToChange(const GraphicsObject* shape) {
+  if (slotOf.empty()) {
+    slotOf.reserve(shapes.size());
+    for (size_t i = 0; i < shapes.size(); i++) slotOf[shapes[i].get()] = i;
+  }
+  auto it = slotOf.find(shape);
+  if (it == slotOf.end()) return;
+  size_t i = it->second;
+  std::lock_guard<std::mutex> hold(lockOf(i));
+  if (written[i] || shapes[i].get() != shape) return;
+  shapes[i] = shapes[i]->clone();
+}
@@ -0,0 +1,115 @@
+// shape_columns.cpp
+// keeps the shape columns in sync with the document
+
+#include "gui/shape_columns.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "shapes/circle.h"
+#include "shapes/hexagon.h"
+#include "shapes/line.h"
+#include "shapes/shape_cast.h"
+
+void ShapeColumns::resize(size_t rows) {
+  left.resize(rows);
+  top.resize(rows);
+  right.resize(rows);
+  bottom.resize(rows);
+  for (auto& column : geom) column.resize(rows);
+  strokeWidth.resize(rows);
+  type.resize(rows);
+  styleFlags.resize(rows);
+  fillArgb.resize(rows);
+  strokeArgb.resize(rows);
+  z.resize(rows);
+  owner.resize(rows);
+}
+
+// copy the fields scans test out of the shape into its row
+void ShapeColumns::capture(uint32_t row) {
+  const GraphicsObject& shape = *owner[row];
+  QRectF box = shape.boundingBox().normalized();
+  left[row] = box.left();
+  top[row] = box.top();
+  right[row] = box.right();
+  bottom[row] = box.bottom();
+  double g[4] = {};
+  bool pointyTop = false;
+  if (auto c = shapeCast<Circle>(&shape)) {
+    double v[] = {c->getCx(), c->getCy(), c->getRx(), c->getRy()};
+    std::copy(std::begin(v), std::end(v), g);
+  } else if (auto h = shapeCast<Hexagon>(&shape)) {
+    double v[] = {h->getCx(), h->getCy(), h->getRx(), h->getRy()};
+    std::copy(std::begin(v), std::end(v), g);
+    pointyTop = h->isPointyTop();
+  } else if (auto l = shapeCast<Line>(&shape)) {
+    double v[] = {l->getX1(), l->getY1(), l->getX2(), l->getY2()};
+    std::copy(std::begin(v), std::end(v), g);
+  }
+  for (int i = 0; i < 4; i++) geom[i][row] = g[i];
+  strokeWidth[row] = static_cast<float>(shape.getStrokeWidth());
+  type[row] = shape.type();
+  const ShapeColor& fill = shape.getFill();
+  const ShapeColor& stroke = shape.getStroke();
+  styleFlags[row] = (fill.none ? kNoFill : 0) | (stroke.none ? kNoStroke : 0) |
+                    (pointyTop ? kPointyTop : 0);
+  fillArgb[row] = fill.argb;
+  strokeArgb[row] = stroke.argb;
+}
+
+void ShapeColumns::rebuild(const ShapeStore& shapes) {
+  rowOf.clear();
+  rowOf.reserve(shapes.size());
+  resize(shapes.size());
+  uint32_t row = 0;
+  for (auto it = shapes.begin(); it != shapes.end(); ++it, ++row) {
+    owner[row] = *it;
+    z[row] = it.z();
+    rowOf[it->get()] = row;
+    capture(row);
+  }
+}
+
+void ShapeColumns::insert(const ShapePtr& shape, ShapeStore::ZKey key) {
+  if (!shape) return;
+  remove(shape.get());
+  auto row = static_cast<uint32_t>(size());
+  resize(row + 1);
+  owner[row] = shape;
+  z[row] = key;
+  rowOf[shape.get()] = row;
+  capture(row);
+}
+
+void ShapeColumns::moveRow(uint32_t from, uint32_t to) {
+  left[to] = left[from];
+  top[to] = top[from];
+  right[to] = right[from];
+  bottom[to] = bottom[from];
+  for (auto& column : geom) column[to] = column[from];
+  strokeWidth[to] = strokeWidth[from];
+  type[to] = type[from];
+  styleFlags[to] = styleFlags[from];
+  fillArgb[to] = fillArgb[from];
+  strokeArgb[to] = strokeArgb[from];
+  z[to] = z[from];
+  owner[to] = std::move(owner[from]);
+  rowOf[owner[to].get()] = to;
+}
+
+// the last row fills the hole so the columns stay dense
+void ShapeColumns::remove(const GraphicsObject* shape) {
+  auto it = rowOf.find(shape);
+  if (it == rowOf.end()) return;
+  uint32_t row = it->second;
+  rowOf.erase(it);
+  auto last = static_cast<uint32_t>(size() - 1);
+  if (row != last) moveRow(last, row);
+  resize(last);
+}
+
+void ShapeColumns::update(const GraphicsObject* shape) {
+  auto it = rowOf.find(shape);
+  if (it != rowOf.end()) capture(it->second);
+}
@@ -0,0 +1,81 @@
+// shape_columns_hit.cpp
+// point hit test over the shape columns with the batch geometry kernels
+
+#include "gui/shape_columns.h"
+#include "shapes/geo_kernels.h"
+#include "shapes/line.h"
+
+namespace {
+// rows that share one kernel call
+enum Group { kEllipses, kFlatHexagons, kPointyHexagons, kSegments, kGroups };
+}  // namespace
+
+// rows are grouped by kernel and their arguments copied into contiguous
+// arrays, so each group is one simd call whatever the row order
+void ShapeColumns::batchHits(const std::vector<uint32_t>& rows, double x,
+                             double y, std::vector<uint8_t>& hits) const {
+  std::vector<size_t> members[kGroups];
+  hits.assign(rows.size(), kAskShape);
+  for (size_t k = 0; k < rows.size(); k++) {
+    uint32_t row = rows[k];
+    if (type[row] == ShapeType::Circle)
+      members[kEllipses].push_back(k);
+    else if (type[row] == ShapeType::Hexagon)
+      members[styleFlags[row] & kPointyTop ? kPointyHexagons : kFlatHexagons]
+          .push_back(k);
+    else if (type[row] == ShapeType::Line)
+      members[kSegments].push_back(k);
+  }
+
+  const GeoKernels::Kernels& kernels = GeoKernels::kernels();
+  std::vector<double> args[4];
+  std::vector<uint8_t> out;
+  std::vector<double> dist;
+  for (int g = 0; g < kGroups; g++) {
+    size_t n = members[g].size();
+    if (n == 0) continue;
+    for (int i = 0; i < 4; i++) {
+      args[i].resize(n);
+      for (size_t j = 0; j < n; j++)
+        args[i][j] = geom[i][rows[members[g][j]]];
+    }
+    const double *a = args[0].data(), *b = args[1].data();
+    const double *c = args[2].data(), *d = args[3].data();
+    out.resize(n);
+    if (g == kEllipses) {
+      kernels.ellipseHits({a, b, c, d, n}, x, y, out.data());
+    } else if (g == kSegments) {
+      // same reach as Line::contains
+      dist.resize(n);
+      kernels.segmentDistSq({a, b, c, d, n}, x, y, dist.data());
+      double reach = Line::kHitDistance * Line::kHitDistance;
+      for (size_t j = 0; j < n; j++) out[j] = dist[j] < reach;
+    } else {
+      kernels.hexagonHits({a, b, c, d, n, g == kPointyHexagons}, x, y,
+                          out.data());
+    }
+    for (size_t j = 0; j < n; j++) hits[members[g][j]] = out[j];
+  }
+}
+
+// candidates keep their front to back order as rows
+ShapeColumns::ShapePtr ShapeColumns::topmostAt(
+    QPointF p, const std::vector<const GraphicsObject*>& candidates,
+    const Filter& filter) const {
+  double x = p.x(), y = p.y();
+  std::vector<uint32_t> rows;
+  rows.reserve(candidates.size());
+  for (const GraphicsObject* shape : candidates) {
+    auto it = rowOf.find(shape);
+    if (it != rowOf.end()) rows.push_back(it->second);
+  }
+
+  std::vector<uint8_t> hits;
+  batchHits(rows, x, y, hits);
+  for (size_t k = 0; k < rows.size(); k++) {
+    const GraphicsObject& shape = *owner[rows[k]];
+    if (hits[k] == 0 || (filter && !filter(shape))) continue;
+    if (hits[k] == 1 || shape.contains(x, y)) return owner[rows[k]];
+  }
+  return nullptr;
+}
@@ -0,0 +1,64 @@
+// shape_columns_query.cpp
+// whole document scans over the shape columns
+
+#include <algorithm>
+
+#include "gui/shape_columns.h"
+
+// the tests are branch free so the loops stream through the bound columns
+// and every row costs the same whatever the outcome
+void ShapeColumns::intersecting(const QRectF& area,
+                                std::vector<ShapePtr>& out) const {
+  double x0 = area.left(), y0 = area.top();
+  double x1 = area.right(), y1 = area.bottom();
+  std::vector<uint32_t> rows(size());
+  size_t kept = 0;
+  for (size_t i = 0; i < rows.size(); i++) {
+    rows[kept] = static_cast<uint32_t>(i);
+    kept += (left[i] <= x1) & (right[i] >= x0) & (top[i] <= y1) &
+            (bottom[i] >= y0);
+  }
+  rows.resize(kept);
+  gather(rows, out);
+}
+
+void ShapeColumns::containedIn(const QRectF& area,
+                               std::vector<ShapePtr>& out) const {
+  double x0 = area.left(), y0 = area.top();
+  double x1 = area.right(), y1 = area.bottom();
+  std::vector<uint32_t> rows(size());
+  size_t kept = 0;
+  for (size_t i = 0; i < rows.size(); i++) {
+    rows[kept] = static_cast<uint32_t>(i);
+    kept += (left[i] >= x0) & (right[i] <= x1) & (top[i] >= y0) &
+            (bottom[i] <= y1);
+  }
+  rows.resize(kept);
+  gather(rows, out);
+}
+
+void ShapeColumns::gather(std::vector<uint32_t>& rows,
+                          std::vector<ShapePtr>& out) const {
+  std::sort(rows.begin(), rows.end(),
+            [this](uint32_t a, uint32_t b) { return z[a] < z[b]; });
+  out.clear();
+  out.reserve(rows.size());
+  for (uint32_t row : rows) out.push_back(owner[row]);
+}
+
+ShapeColumns::Stats ShapeColumns::stats() const {
+  Stats s;
+  s.shapes = size();
+  if (s.shapes == 0) return s;
+  for (ShapeType t : type) s.byType[static_cast<size_t>(t)]++;
+  for (size_t i = 0; i < s.shapes; i++) {
+    s.filled += !(styleFlags[i] & kNoFill);
+    s.stroked += !(styleFlags[i] & kNoStroke) & (strokeWidth[i] > 0);
+  }
+  double x0 = *std::min_element(left.begin(), left.end());
+  double y0 = *std::min_element(top.begin(), top.end());
+  double x1 = *std::max_element(right.begin(), right.end());
+  double y1 = *std::max_element(bottom.begin(), bottom.end());
+  s.bounds = QRectF(QPointF(x0, y0), QPointF(x1, y1));
+  return s;
+}
@@ -0,0 +1,125 @@
+// shape_index.cpp
+// loose quadtree maintenance for the canvas shape index
+
+#include "gui/shape_index.h"
+
+#include <algorithm>
+
+namespace {
+const int kMaxDepth = 16;
+
+// too many parked entries means the root no longer covers the drawing
+bool tooManyParked(size_t parked, size_t total) {
+  return parked > 32 + total / 8;
+}
+}  // namespace
+
+// replace every entry, z stamps are the keys of the store
+void ShapeIndex::rebuild(const ShapeStore& shapes) {
+  entries.clear();
+  entries.reserve(shapes.size());
+  for (auto it = shapes.begin(); it != shapes.end(); ++it) {
+    Entry& e = entries[it->get()];
+    e.shape = *it;
+    e.z = it.z();
+    capture(e);
+  }
+  resetTree();
+}
+
+// z is the key the store gave the shape, a restored shape takes back its
+// old place between the others
+void ShapeIndex::insert(const ShapePtr& shape, ShapeStore::ZKey z) {
+  if (!shape) return;
+  remove(shape.get());
+  if (nodes.empty()) resetTree();
+  Entry& e = entries[shape.get()];
+  e.shape = shape;
+  e.z = z;
+  capture(e);
+  place(e);
+  if (tooManyParked(overflow, entries.size())) resetTree();
+}
+
+// drop a shape from the index if it is present
+void ShapeIndex::remove(const GraphicsObject* shape) {
+  auto it = entries.find(shape);
+  if (it == entries.end()) return;
+  unplace(it->second);
+  entries.erase(it);
+}
+
+// move an entry to the cell matching its new bounds
+QRectF ShapeIndex::update(const ShapePtr& shape) {
+  if (!shape) return QRectF();
+  auto it = entries.find(shape.get());
+  if (it == entries.end()) return QRectF();
+  QRectF old = paintBounds(it->second.box, it->second.stroke);
+  unplace(it->second);
+  capture(it->second);
+  place(it->second);
+  if (tooManyParked(overflow, entries.size())) resetTree();
+  return old;
+}
+
+// read the geometry the index caches for a shape
+void ShapeIndex::capture(Entry& entry) {
+  entry.box = entry.shape->boundingBox().normalized();
+  entry.stroke = entry.shape->getStrokeWidth();
+}
+
+// size the root square around the current drawing and re-place everything
+void ShapeIndex::resetTree() {
+  QRectF world;
+  for (auto& kv : entries) world = world.united(placeBox(kv.second));
+  double side = std::max({world.width(), world.height(), 256.0});
+  QPointF c = world.isNull() ? QPointF(0, 0) : world.center();
+
+  // root is twice the drawing so shapes can move a while before parking
+  nodes.clear();
+  Node root;
+  root.cell = QRectF(c.x() - side, c.y() - side, 2 * side, 2 * side);
+  nodes.push_back(root);
+  overflow = 0;
+  for (auto& kv : entries) place(kv.second);
+}
+
+// descend to the deepest cell whose loose bounds still hold the entry
+void ShapeIndex::place(Entry& entry) {
+  QRectF box = placeBox(entry);
+  QPointF c = box.center();
+  double size = std::max(box.width(), box.height());
+  int idx = 0;
+  entry.parked = !nodes[0].cell.contains(c) || size > nodes[0].cell.width();
+  if (entry.parked) overflow++;
+
+  while (!entry.parked && nodes[idx].depth < kMaxDepth) {
+    QRectF cell = nodes[idx].cell;
+    double half = cell.width() / 2.0;
+    if (size > half) break;
+    int q = (c.x() >= cell.x() + half ? 1 : 0) +
+            (c.y() >= cell.y() + half ? 2 : 0);
+    if (nodes[idx].children[q] < 0) {
+      Node child;
+      child.cell = QRectF(cell.x() + (q & 1) * half,
+                          cell.y() + (q >> 1) * half, half, half);
+      child.depth = nodes[idx].depth + 1;
+      nodes.push_back(child);
+      nodes[idx].children[q] = static_cast<int>(nodes.size()) - 1;
+    }
+    idx = nodes[idx].children[q];
+  }
+  entry.node = idx;
+  nodes[idx].items.push_back(&entry);
+}
+
+// detach an entry from the cell it was placed in
+void ShapeIndex::unplace(const Entry& entry) {
+  auto& items = nodes[entry.node].items;
+  auto it = std::find(items.begin(), items.end(), &entry);
+  if (it != items.end()) {
+    *it = items.back();
+    items.pop_back();
+  }
+  if (entry.parked) overflow--;
+}
@@ -0,0 +1,97 @@
+// shape_index_query.cpp
+// point and area queries against the canvas shape index
+
+#include <algorithm>
+
+#include "gui/shape_index.h"
+
+namespace {
+// hit tests for lines and freehand strokes reach a few pixels past the box
+const double kHitSlop = 8.0;
+// extra pixels touched by antialiasing around a stroke
+const double kAntialiasPad = 2.0;
+}  // namespace
+
+QRectF ShapeIndex::hitBox(const QRectF& box) {
+  return box.adjusted(-kHitSlop, -kHitSlop, kHitSlop, kHitSlop);
+}
+
+// full stroke width covers miter joins as well as the half width outside
+QRectF ShapeIndex::paintBounds(const QRectF& box, double strokeWidth) {
+  double pad = strokeWidth + kAntialiasPad;
+  return box.adjusted(-pad, -pad, pad, pad);
+}
+
+QRectF ShapeIndex::placeBox(const Entry& entry) {
+  double pad = std::max(kHitSlop, entry.stroke + kAntialiasPad);
+  return entry.box.adjusted(-pad, -pad, pad, pad);
+}
+
+// loose bounds let items overhang their cell by half the cell side
+QRectF ShapeIndex::looseBounds(const Node& node) {
+  double h = node.cell.width() / 2.0;
+  return node.cell.adjusted(-h, -h, h, h);
+}
+
+// cached bounds used for repaint regions and culling
+QRectF ShapeIndex::boundsOf(const GraphicsObject* shape) const {
+  auto it = entries.find(shape);
+  return it == entries.end() ? QRectF() : it->second.box;
+}
+
+QRectF ShapeIndex::paintBoundsOf(const GraphicsObject* shape) const {
+  auto it = entries.find(shape);
+  if (it == entries.end()) return QRectF();
+  return paintBounds(it->second.box, it->second.stroke);
+}
+
+// gather entries whose hit box holds the point, root items are always checked
+void ShapeIndex::collect(int node, QPointF p,
+                         std::vector<const Entry*>& out) const {
+  const Node& n = nodes[node];
+  for (const Entry* e : n.items) {
+    if (hitBox(e->box).contains(p)) out.push_back(e);
+  }
+  for (int child : n.children) {
+    if (child >= 0 && looseBounds(nodes[child]).contains(p))
+      collect(child, p, out);
+  }
+}
+
+// sorted front to back so the first accepted candidate is the topmost
+void ShapeIndex::candidatesAt(QPointF p,
+                              std::vector<const GraphicsObject*>& out) const {
+  out.clear();
+  if (nodes.empty()) return;
+  std::vector<const Entry*> hits;
+  collect(0, p, hits);
+  std::sort(hits.begin(), hits.end(),
+            [](const Entry* a, const Entry* b) { return a->z > b->z; });
+  out.reserve(hits.size());
+  for (const Entry* e : hits) out.push_back(e->shape.get());
+}
+
+// gather entries whose paint bounds meet the area
+void ShapeIndex::collect(int node, const QRectF& area,
+                         std::vector<const Entry*>& out) const {
+  const Node& n = nodes[node];
+  for (const Entry* e : n.items) {
+    if (paintBounds(e->box, e->stroke).intersects(area)) out.push_back(e);
+  }
+  for (int child : n.children) {
+    if (child >= 0 && looseBounds(nodes[child]).intersects(area))
+      collect(child, area, out);
+  }
+}
+
+// shapes to draw for an exposed area, in document order
+void ShapeIndex::query(const QRectF& area, std::vector<ShapePtr>& out) const {
+  out.clear();
+  if (nodes.empty()) return;
+  std::vector<const Entry*> hits;
+  collect(0, area, hits);
+  std::sort(hits.begin(), hits.end(),
+            [](const Entry* a, const Entry* b) { return a->z < b->z; });
+  out.reserve(hits.size());
+  for (const Entry* e : hits) out.push_back(e->shape);
+}
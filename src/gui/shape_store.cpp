@@ -0,0 +1,112 @@
+// shape_store.cpp
+// slot map of document shapes with stable ids and a separate z order
+
+#include "gui/shape_store.h"
+
+#include <algorithm>
+
+ShapeStore::Id ShapeStore::insertTop(ShapePtr shape) {
+  return insertAt(std::move(shape), nextZ);
+}
+
+// a shape already in the store moves to the new key
+ShapeStore::Id ShapeStore::insertAt(ShapePtr shape, ZKey z) {
+  if (!shape) return Id();
+  remove(shape.get());
+  if (z == 0 || order.count(z)) z = nextZ;
+  nextZ = std::max(nextZ, z + 1);
+
+  uint32_t slot;
+  if (!freeSlots.empty()) {
+    slot = freeSlots.back();
+    freeSlots.pop_back();
+  } else {
+    slot = static_cast<uint32_t>(table.size());
+    table.emplace_back();
+  }
+  Slot& s = table[slot];
+  s.z = z;
+  slotOf[shape.get()] = slot;
+  s.shape = std::move(shape);
+  order.emplace(z, slot);
+  return Id{slot, s.generation};
+}
+
+ShapeStore::ZKey ShapeStore::remove(const GraphicsObject* shape) {
+  auto it = slotOf.find(shape);
+  if (it == slotOf.end()) return 0;
+  Slot& s = table[it->second];
+  ZKey z = s.z;
+  order.erase(z);
+  freeSlots.push_back(it->second);
+  slotOf.erase(it);
+  s.shape = nullptr;
+  s.z = 0;
+  s.generation++;
+  return z;
+}
+
+ShapeStore::ShapePtr ShapeStore::removeAt(ZKey z) {
+  ShapePtr shape = at(z);
+  if (shape) remove(shape.get());
+  return shape;
+}
+
+void ShapeStore::assign(const std::vector<ShapePtr>& shapes,
+                        const std::vector<ZKey>& keys) {
+  clear();
+  table.reserve(shapes.size());
+  slotOf.reserve(shapes.size());
+  bool keyed = keys.size() == shapes.size() &&
+               std::is_sorted(keys.begin(), keys.end()) &&
+               std::adjacent_find(keys.begin(), keys.end()) == keys.end();
+  for (size_t i = 0; i < shapes.size(); i++) {
+    if (keyed)
+      insertAt(shapes[i], keys[i]);
+    else
+      insertTop(shapes[i]);
+  }
+}
+
+// generations survive a clear so ids handed out before stay stale
+void ShapeStore::clear() {
+  for (uint32_t i = 0; i < table.size(); i++) {
+    if (!table[i].shape) continue;
+    table[i].shape = nullptr;
+    table[i].z = 0;
+    table[i].generation++;
+  }
+  freeSlots.clear();
+  for (uint32_t i = static_cast<uint32_t>(table.size()); i > 0; i--)
+    freeSlots.push_back(i - 1);
+  slotOf.clear();
+  order.clear();
+  nextZ = 1;
+}
+
+ShapeStore::ZKey ShapeStore::zOf(const GraphicsObject* shape) const {
+  auto it = slotOf.find(shape);
+  return it == slotOf.end() ? 0 : table[it->second].z;
+}
+
+ShapeStore::Id ShapeStore::idOf(const GraphicsObject* shape) const {
+  auto it = slotOf.find(shape);
+  if (it == slotOf.end()) return Id();
+  return Id{it->second, table[it->second].generation};
+}
+
+ShapeStore::ShapePtr ShapeStore::get(Id id) const {
+  if (id.slot >= table.size()) return nullptr;
+  const Slot& s = table[id.slot];
+  return s.generation == id.generation ? s.shape : nullptr;
+}
+
+ShapeStore::ShapePtr ShapeStore::at(ZKey z) const {
+  auto it = order.find(z);
+  return it == order.end() ? nullptr : table[it->second].shape;
+}
+
+ShapeStore::const_iterator ShapeStore::find(const GraphicsObject* shape) const {
+  ZKey z = zOf(shape);
+  return {z ? order.find(z) : order.end(), this};
+}
@@ -0,0 +1,32 @@
+// svg_load_worker.cpp
+// background svg loader that hands shapes to the gui thread in batches
+
+#include "gui/svg_load_worker.h"
+
+#include "parse/svg_stream_reader.h"
+
+SvgLoadWorker::SvgLoadWorker(const QString& path, double simplifyTolerance)
+    : path(path), simplifyTolerance(simplifyTolerance) {
+  // batches cross threads through queued connections
+  qRegisterMetaType<ShapeBatch>("ShapeBatch");
+}
+
+void SvgLoadWorker::cancel() { cancelled = true; }
+
+// read block by block until the file ends or the user cancels
+void SvgLoadWorker::run() {
+  SvgParser::StreamReader reader(path.toStdString(), simplifyTolerance);
+  if (!reader.isOpen()) {
+    emit finished(false, false, 0);
+    return;
+  }
+  while (!cancelled && !reader.atEnd()) {
+    ShapeBatch batch;
+    reader.next(batch);
+    if (!batch.empty()) emit batchReady(std::move(batch));
+    size_t total = reader.totalBytes();
+    emit progress(total ? static_cast<int>(reader.bytesRead() * 100 / total)
+                        : 100);
+  }
+  emit finished(true, cancelled, reader.removedPoints());
+}
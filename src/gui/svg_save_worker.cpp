@@ -0,0 +1,45 @@
+// svg_save_worker.cpp
+// background svg writer that saves a snapshot of the document
+
+#include "gui/svg_save_worker.h"
+
+#include <QSaveFile>
+
+#include "shapes/binary_format.h"
+#include "shapes/svg_document.h"
+
+SvgSaveWorker::SvgSaveWorker(const QString& path, int width, int height,
+                             std::shared_ptr<SaveSnapshot> snapshot)
+    : path(path), width(width), height(height), snapshot(std::move(snapshot)) {}
+
+// QSaveFile writes a temp file next to the target, commit() syncs it to
+// disk and renames it over the target so a crash never leaves half a file
+// a .pikb path gets the native binary document instead of svg
+void SvgSaveWorker::run() {
+  std::string bytes;
+  std::string target = path.toStdString();
+  if (BinaryFormat::isBinaryPath(target)) {
+    BinaryFormat::Writer writer;
+    snapshot->write(0, snapshot->size(), [&](const GraphicsObject& shape) {
+      shape.writeBinary(writer);
+    });
+    bytes = writer.finish(width, height);
+  } else {
+    SvgWriter out;
+    writeSvgDocument(out, width, height, snapshot->size(),
+                     [&](SvgWriter& part, size_t first, size_t last) {
+                       snapshot->write(first, last,
+                                       [&](const GraphicsObject& shape) {
+                                         writeSvgShape(part, shape);
+                                       });
+                     });
+    bytes = out.data();
+  }
+  QSaveFile file(path);
+  qint64 size = static_cast<qint64>(bytes.size());
+  ok = size > 0 && file.open(QIODevice::WriteOnly) &&
+       file.write(bytes.data(), size) == size && file.commit();
+  emit finished();
+}
+
+bool SvgSaveWorker::succeeded() const { return ok; }
@@ -0,0 +1,118 @@
+// binary_reader.cpp
+// builds shapes straight from the records of a mapped native document
+
+#include "parse/binary_reader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include "parse/mapped_file.h"
+#include "shapes/binary_format.h"
+#include "shapes/circle.h"
+#include "shapes/freehand.h"
+#include "shapes/hexagon.h"
+#include "shapes/line.h"
+#include "shapes/rectangle.h"
+#include "shapes/rounded_rectangle.h"
+#include "shapes/text_shape.h"
+
+namespace BinaryFormat {
+
+namespace {
+
+using ShapePtr = std::shared_ptr<GraphicsObject>;
+
+// section of count items of size bytes at offset lies inside the file
+bool fits(std::string_view file, uint64_t offset, uint64_t count,
+          uint64_t size) {
+  return offset <= file.size() && count <= (file.size() - offset) / size;
+}
+
+// packed colour of a record, or the named colour its value points at
+ShapeColor readColor(uint32_t value, bool none, bool named,
+                     std::string_view strings) {
+  if (!named) return ShapeColor{value, none};
+  if (value >= strings.size()) return ShapeColor();
+  std::string_view rest = strings.substr(value);
+  return ShapeColor::fromString(std::string(rest.substr(0, rest.find('\0'))));
+}
+
+// dispatch generated from SHAPE_TYPES, every class reads its own record
+ShapePtr makeShape(ShapeType type, const RecordView& in) {
+  switch (type) {
+#define SHAPE_FROM_RECORD(tag, cls, name) \
+  case ShapeType::tag:                    \
+    return cls::fromRecord(in);
+    SHAPE_TYPES(SHAPE_FROM_RECORD)
+#undef SHAPE_FROM_RECORD
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace
+
+std::vector<ShapePtr> load(const std::string& path, bool* ok) {
+  if (ok) *ok = false;
+  MappedFile mapped(path);
+  std::string_view file = mapped.data();
+  FileHeader h;
+  if (!mapped.isOpen() || file.size() < sizeof(h)) return {};
+  std::memcpy(&h, file.data(), sizeof(h));
+  if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 ||
+      h.version != kVersion || h.recordSize != sizeof(ShapeRecord) ||
+      !fits(file, h.typeTableOffset, h.typeCount, sizeof(TypeEntry)) ||
+      !fits(file, h.recordsOffset, h.shapeCount, sizeof(ShapeRecord)) ||
+      !fits(file, h.pointsOffset, h.pointCount, sizeof(QPointF)) ||
+      !fits(file, h.stringsOffset, h.stringBytes, 1))
+    return {};
+
+  // record type ids go through the name table, records of unknown names
+  // are skipped
+  ShapeType types[256];
+  std::fill(std::begin(types), std::end(types), ShapeType::Count);
+  for (uint32_t i = 0; i < h.typeCount; i++) {
+    TypeEntry e;
+    const char* at = file.data() + h.typeTableOffset + i * sizeof(e);
+    std::memcpy(&e, at, sizeof(e));
+    e.name[sizeof(e.name) - 1] = '\0';
+    for (int t = 0; t < static_cast<int>(ShapeType::Count); t++)
+      if (std::strcmp(e.name, shapeTypeName(static_cast<ShapeType>(t))) == 0)
+        types[e.id] = static_cast<ShapeType>(t);
+  }
+
+  const char* points = file.data() + h.pointsOffset;
+  const char* strings = file.data() + h.stringsOffset;
+  std::vector<ShapePtr> shapes;
+  shapes.reserve(h.shapeCount);
+  uint64_t skipped = 0;
+  for (uint64_t i = 0; i < h.shapeCount; i++) {
+    ShapeRecord r;
+    std::memcpy(&r, file.data() + h.recordsOffset + i * sizeof(r), sizeof(r));
+    ShapeType type = types[r.type];
+    uint64_t limit = type == ShapeType::Freehand ? h.pointCount : h.stringBytes;
+    if (r.dataOffset > limit || r.dataCount > limit - r.dataOffset ||
+        r.dataCount2 > limit - r.dataOffset - r.dataCount) {
+      skipped++;
+      continue;
+    }
+    ShapePtr s = makeShape(type, RecordView{r, points, strings});
+    if (!s) {
+      skipped++;
+      continue;
+    }
+    std::string_view table(strings, h.stringBytes);
+    s->setFillColor(readColor(r.fill, r.flags & kFillNone,
+                              r.flags & kFillNamed, table));
+    s->setStrokeColor(readColor(r.stroke, r.flags & kStrokeNone,
+                                r.flags & kStrokeNamed, table));
+    s->setStrokeWidth(r.strokeWidth);
+    shapes.push_back(std::move(s));
+  }
+  // the readable shapes still come back, but the file was not read whole
+  if (ok) *ok = skipped == 0;
+  return shapes;
+}
+
+}  // namespace BinaryFormat
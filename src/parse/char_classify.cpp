@@ -0,0 +1,84 @@
+// char_classify.cpp
+// scalar, sse4.2 and avx2 kernels for classifying separator and digit bytes
+
+#include "parse/char_classify.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SVG_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace SvgParser {
+
+CharMasks classifyScalar(const char* block) {
+  CharMasks m;
+  for (int i = 0; i < 64; i++) {
+    char c = block[i];
+    bool sep = c == ' ' || c == ',' || c == '\t' || c == '\n' || c == '\r';
+    m.separator |= uint64_t(sep) << i;
+    m.digit |= uint64_t(c >= '0' && c <= '9') << i;
+  }
+  return m;
+}
+
+#ifdef SVG_X86_KERNELS
+
+// pcmpestrm matches each byte against a set or a range, explicit lengths so
+// a stray nul byte does not end the compare early
+__attribute__((target("sse4.2"))) static CharMasks classifySse42(
+    const char* block) {
+  const __m128i seps = _mm_setr_epi8(' ', ',', '\t', '\n', '\r', 0, 0, 0, 0,
+                                     0, 0, 0, 0, 0, 0, 0);
+  const __m128i digits = _mm_setr_epi8('0', '9', 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                       0, 0, 0, 0, 0);
+  CharMasks m;
+  for (int k = 0; k < 4; k++) {
+    __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * k));
+    __m128i s = _mm_cmpestrm(seps, 5, v, 16,
+                             _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY |
+                                 _SIDD_BIT_MASK);
+    __m128i d = _mm_cmpestrm(digits, 2, v, 16,
+                             _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES |
+                                 _SIDD_BIT_MASK);
+    m.separator |= uint64_t(uint16_t(_mm_cvtsi128_si32(s))) << (16 * k);
+    m.digit |= uint64_t(uint16_t(_mm_cvtsi128_si32(d))) << (16 * k);
+  }
+  return m;
+}
+
+// byte compares, a digit is a byte whose offset from '0' is at most 9
+__attribute__((target("avx2"))) static CharMasks classifyAvx2(
+    const char* block) {
+  CharMasks m;
+  for (int k = 0; k < 2; k++) {
+    __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32 * k));
+    __m256i s = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+                        _mm256_cmpeq_epi8(v, _mm256_set1_epi8(','))),
+        _mm256_or_si256(
+            _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t')),
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')),
+                            _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r')))));
+    __m256i off = _mm256_sub_epi8(v, _mm256_set1_epi8('0'));
+    __m256i d = _mm256_cmpeq_epi8(
+        _mm256_min_epu8(off, _mm256_set1_epi8(9)), off);
+    m.separator |= uint64_t(uint32_t(_mm256_movemask_epi8(s))) << (32 * k);
+    m.digit |= uint64_t(uint32_t(_mm256_movemask_epi8(d))) << (32 * k);
+  }
+  return m;
+}
+
+#endif
+
+ClassifyFn selectClassifier() {
+#ifdef SVG_X86_KERNELS
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) return classifyAvx2;
+  if (__builtin_cpu_supports("sse4.2")) return classifySse42;
+#endif
+  return classifyScalar;
+}
+
+}  // namespace SvgParser
@@ -0,0 +1,66 @@
+// mapped_file.cpp
+// mmap based file input with a single buffer read as fallback
+
+#include "parse/mapped_file.h"
+
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define INKSCAPE_HAVE_MMAP 1
+#endif
+
+MappedFile::MappedFile(const std::string& path) {
+  open = map(path) || readAll(path);
+}
+
+MappedFile::~MappedFile() {
+#ifdef INKSCAPE_HAVE_MMAP
+  if (mapped) munmap(const_cast<char*>(mapped), mappedSize);
+#endif
+}
+
+bool MappedFile::isOpen() const { return open; }
+
+std::string_view MappedFile::data() const {
+  if (mapped) return std::string_view(mapped, mappedSize);
+  return buffer;
+}
+
+// map the file read only and tell the kernel it will be read front to back
+bool MappedFile::map(const std::string& path) {
+#ifdef INKSCAPE_HAVE_MMAP
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+    ::close(fd);
+    return false;
+  }
+  size_t size = static_cast<size_t>(st.st_size);
+  void* p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);  // the mapping keeps its own reference to the file
+  if (p == MAP_FAILED) return false;
+  madvise(p, size, MADV_SEQUENTIAL);
+  mapped = static_cast<const char*>(p);
+  mappedSize = size;
+  return true;
+#else
+  (void)path;
+  return false;
+#endif
+}
+
+// one allocation sized from the file length, no intermediate stream copy
+bool MappedFile::readAll(const std::string& path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) return false;
+  std::streamoff size = file.tellg();
+  if (size < 0) return false;
+  buffer.resize(static_cast<size_t>(size));
+  file.seekg(0);
+  return static_cast<bool>(file.read(buffer.data(), size)) || size == 0;
+}
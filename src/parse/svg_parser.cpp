@@ -4,36 +4,43 @@
 
 #include "parse/svg_parser.h"
 
-#include <fstream>
-#include <sstream>
+#include <algorithm>
 
+#include "parse/mapped_file.h"
 #include "parse/svg_parser_internal.h"
+#include "shapes/freehand.h"
+#include "shapes/shape_cast.h"
 
 namespace SvgParser {
 
 // main entry point for loading an svg file, returns vector of shapes
-std::vector<std::shared_ptr<GraphicsObject>> load(const std::string& filePath) {
-  std::ifstream file(filePath);
-  if (!file.is_open()) return {};
-  std::ostringstream ss;
-  ss << file.rdbuf();
-  std::string content = ss.str();
-
-  std::vector<std::shared_ptr<GraphicsObject>> shapes;
+// parses straight from the mapped file so only one copy of it is resident
+std::vector<std::shared_ptr<GraphicsObject>> load(const std::string& filePath,
+                                                  double simplifyTolerance,
+                                                  size_t* removedPoints) {
+  MappedFile file(filePath);
+  if (!file.isOpen()) return {};
+  return parse(file.data(), simplifyTolerance, removedPoints);
+}
+
+// parse every element in a run of svg text, appending shapes in order
+// tags and attributes are views into doc, nothing is copied per tag
+void parseRange(std::string_view doc, ShapeVec& shapes) {
+  AttrMap attrs;
   size_t pos = 0;
-  while (pos < content.size()) {
+  while (pos < doc.size()) {
     // scan next tag and parse attribute list
-    size_t open = content.find('<', pos);
-    if (open == std::string::npos) break;
-    size_t close = content.find('>', open);
-    if (close == std::string::npos) break;
-    std::string tag = content.substr(open + 1, close - open - 1);
+    size_t open = doc.find('<', pos);
+    if (open == std::string_view::npos) break;
+    size_t close = doc.find('>', open);
+    if (close == std::string_view::npos) break;
+    std::string_view tag = doc.substr(open + 1, close - open - 1);
     pos = close + 1;
     if (tag.empty() || tag[0] == '/' || tag[0] == '?' || tag[0] == '!')
       continue;
-    size_t nameEnd = tag.find_first_of(" />");
-    std::string tagName = tag.substr(0, nameEnd);
-    auto attrs = parseAttributes(tag.substr(nameEnd));
+    size_t nameEnd = std::min(tag.find_first_of(" \t\r\n/>"), tag.size());
+    std::string_view tagName = tag.substr(0, nameEnd);
+    parseAttributes(tag.substr(nameEnd), attrs);
 
     // dispatch by tag name to specialized parsers
     if (tagName == "rect") {
@@ -45,9 +52,9 @@ std::vector<std::shared_ptr<GraphicsObject>> load(const std::string& filePath) {
     } else if (tagName == "line") {
       parseLine(attrs, shapes);
     } else if (tagName == "text") {
-      size_t tc = content.find("</text>", pos);
-      if (tc == std::string::npos) continue;
-      std::string raw = content.substr(pos, tc - pos);
+      size_t tc = doc.find("</text>", pos);
+      if (tc == std::string_view::npos) continue;
+      std::string_view raw = doc.substr(pos, tc - pos);
       pos = tc + 7;
       parseText(attrs, raw, shapes);
     } else if (tagName == "polyline") {
@@ -56,7 +63,17 @@ std::vector<std::shared_ptr<GraphicsObject>> load(const std::string& filePath) {
       parsePolygon(attrs, shapes);
     }
   }
-  return shapes;
+}
+
+// optional simplification pass over imported freehand strokes
+size_t simplifyRange(const ShapeVec& shapes, double tolerance) {
+  size_t removed = 0;
+  if (tolerance <= 0) return removed;
+  for (const auto& s : shapes) {
+    auto fh = shapeCast<Freehand>(s);
+    if (fh) removed += fh->simplify(tolerance);
+  }
+  return removed;
 }
 
 }  // namespace SvgParser
@@ -0,0 +1,89 @@
+// svg_parser_attrs.cpp
+// attribute tokenizer and key interning for the svg parser
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "parse/svg_parser_internal.h"
+
+namespace SvgParser {
+
+namespace {
+using KeyName = std::pair<std::string_view, AttrKey>;
+
+// sorted by name so lookups can binary search
+constexpr std::array<KeyName, 28> kKeys{{
+    {"cx", AttrKey::Cx},
+    {"cy", AttrKey::Cy},
+    {"data-cx", AttrKey::DataCx},
+    {"data-cy", AttrKey::DataCy},
+    {"data-highlight-fill", AttrKey::DataHighlightFill},
+    {"data-orientation", AttrKey::DataOrientation},
+    {"data-rx", AttrKey::DataRx},
+    {"data-ry", AttrKey::DataRy},
+    {"data-shape", AttrKey::DataShape},
+    {"fill", AttrKey::Fill},
+    {"fill-opacity", AttrKey::FillOpacity},
+    {"font-family", AttrKey::FontFamily},
+    {"font-size", AttrKey::FontSize},
+    {"height", AttrKey::Height},
+    {"points", AttrKey::Points},
+    {"r", AttrKey::R},
+    {"rx", AttrKey::Rx},
+    {"ry", AttrKey::Ry},
+    {"stroke", AttrKey::Stroke},
+    {"stroke-opacity", AttrKey::StrokeOpacity},
+    {"stroke-width", AttrKey::StrokeWidth},
+    {"width", AttrKey::Width},
+    {"x", AttrKey::X},
+    {"x1", AttrKey::X1},
+    {"x2", AttrKey::X2},
+    {"y", AttrKey::Y},
+    {"y1", AttrKey::Y1},
+    {"y2", AttrKey::Y2},
+}};
+
+bool isSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+}  // namespace
+
+AttrKey internKey(std::string_view name) {
+  auto it = std::lower_bound(
+      kKeys.begin(), kKeys.end(), name,
+      [](const KeyName& k, std::string_view n) { return k.first < n; });
+  return (it != kKeys.end() && it->first == name) ? it->second
+                                                  : AttrKey::Unknown;
+}
+
+const std::string_view* AttrMap::find(AttrKey key) const {
+  for (int i = 0; i < count; i++) {
+    if (items[i].key == key) return &items[i].value;
+  }
+  return nullptr;
+}
+
+// parse attributes from one xml tag text without copying any of it
+void parseAttributes(std::string_view tag, AttrMap& out) {
+  out.count = 0;
+  size_t pos = 0;
+  while (pos < tag.size()) {
+    while (pos < tag.size() && (isSpace(tag[pos]) || tag[pos] == '/')) pos++;
+    size_t eq = tag.find('=', pos);
+    if (eq == std::string_view::npos) break;
+    std::string_view key = tag.substr(pos, eq - pos);
+    while (!key.empty() && isSpace(key.back())) key.remove_suffix(1);
+    size_t q1 = tag.find_first_of("\"'", eq);
+    if (q1 == std::string_view::npos) break;
+    size_t q2 = tag.find(tag[q1], q1 + 1);
+    if (q2 == std::string_view::npos) break;
+    pos = q2 + 1;
+
+    AttrKey k = internKey(key);
+    if (k == AttrKey::Unknown || out.count == AttrMap::kMaxAttrs) continue;
+    out.items[out.count++] = {k, tag.substr(q1 + 1, q2 - q1 - 1)};
+  }
+}
+
+}  // namespace SvgParser
@@ -0,0 +1,114 @@
+// svg_parser_parallel.cpp
+// splits large svg text into chunks and parses them on worker threads
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "parse/svg_parser.h"
+#include "parse/svg_parser_internal.h"
+
+namespace SvgParser {
+
+namespace {
+// below this size thread start up costs more than it saves
+const size_t kMinChunkBytes = 256 * 1024;
+// more chunks than workers so uneven chunks still balance out
+const size_t kChunksPerWorker = 4;
+// exported shapes take more text than this, so reserving by it keeps the
+// chunk shape lists from regrowing
+const size_t kMinShapeBytes = 64;
+
+// next '<' at or after pos that opens an element, closing tags stay with
+// their element
+size_t nextOpenTag(std::string_view doc, size_t pos) {
+  while ((pos = doc.find('<', pos)) != std::string_view::npos &&
+         pos + 1 < doc.size() && doc[pos + 1] == '/')
+    pos++;
+  return pos;
+}
+
+// a cut inside a text element, say between two of its tspan children,
+// would leave the first chunk without the </text> parseRange looks for, so
+// such cuts move past that close tag
+// only the chunk being cut is searched, text before start belongs to the
+// previous chunk
+size_t skipOpenText(std::string_view doc, size_t start, size_t cut) {
+  std::string_view chunk = doc.substr(start, cut - start);
+  size_t open = chunk.rfind("<text");
+  while (open != std::string_view::npos) {
+    // <textPath and the like are children, keep looking for the element
+    char next = open + 5 < chunk.size() ? chunk[open + 5] : '>';
+    if (next == '>' || next == '/' || next == ' ' || next == '\t' ||
+        next == '\r' || next == '\n') {
+      size_t close = doc.find("</text>", start + open);
+      if (close == std::string_view::npos) return std::string_view::npos;
+      return close < cut ? cut : nextOpenTag(doc, close + 7);
+    }
+    if (open == 0) break;
+    open = chunk.rfind("<text", open - 1);
+  }
+  return cut;
+}
+
+}  // namespace
+
+std::vector<std::string_view> splitChunks(std::string_view doc, size_t count) {
+  std::vector<std::string_view> chunks;
+  size_t start = 0;
+  for (size_t i = 1; i < count && start < doc.size(); i++) {
+    size_t cut = nextOpenTag(doc, std::max(start, doc.size() / count * i));
+    if (cut != std::string_view::npos) cut = skipOpenText(doc, start, cut);
+    if (cut == std::string_view::npos || cut <= start) continue;
+    chunks.push_back(doc.substr(start, cut - start));
+    start = cut;
+  }
+  chunks.push_back(doc.substr(start));
+  return chunks;
+}
+
+// chunks are parsed independently and concatenated in document order so the
+// resulting z order is the same as a sequential parse
+std::vector<std::shared_ptr<GraphicsObject>> parse(std::string_view doc,
+                                                   double simplifyTolerance,
+                                                   size_t* removedPoints) {
+  size_t workers = std::max(1u, std::thread::hardware_concurrency());
+  workers = std::min(workers, doc.size() / kMinChunkBytes + 1);
+  auto chunks = splitChunks(doc, workers == 1 ? 1 : workers * kChunksPerWorker);
+
+  // each chunk collects into its own list, only one worker touches it
+  std::vector<ShapeVec> parts(chunks.size());
+  for (size_t i = 0; i < chunks.size(); i++)
+    parts[i].reserve(chunks[i].size() / kMinShapeBytes + 1);
+  std::vector<size_t> removed(chunks.size(), 0);
+  std::atomic<size_t> next{0};
+  auto work = [&]() {
+    size_t i = next.fetch_add(1);
+    while (i < chunks.size()) {
+      parseRange(chunks[i], parts[i]);
+      removed[i] = simplifyRange(parts[i], simplifyTolerance);
+      i = next.fetch_add(1);
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (size_t t = 1; t < std::min(workers, chunks.size()); t++)
+    pool.emplace_back(work);
+  work();
+  for (auto& th : pool) th.join();
+
+  size_t total = 0, removedTotal = 0;
+  for (size_t i = 0; i < parts.size(); i++) {
+    total += parts[i].size();
+    removedTotal += removed[i];
+  }
+  std::vector<std::shared_ptr<GraphicsObject>> shapes;
+  shapes.reserve(total);
+  for (auto& part : parts)
+    shapes.insert(shapes.end(), std::make_move_iterator(part.begin()),
+                  std::make_move_iterator(part.end()));
+  if (removedPoints) *removedPoints = removedTotal;
+  return shapes;
+}
+
+}  // namespace SvgParser
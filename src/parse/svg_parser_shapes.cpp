@@ -3,8 +3,6 @@
 // implementations of the freehand and polygon are parsed when
 // they contain the tags
 
-#include <sstream>
-
 #include "parse/svg_parser_internal.h"
 #include "shapes/circle.h"
 #include "shapes/freehand.h"
@@ -12,6 +10,7 @@
 #include "shapes/line.h"
 #include "shapes/rectangle.h"
 #include "shapes/rounded_rectangle.h"
+#include "shapes/shape_pool.h"
 #include "shapes/text_shape.h"
 
 namespace SvgParser {
@@ -19,23 +18,23 @@ namespace SvgParser {
 // apply common style attributes like fill, stroke and stroke-width to a shape
 static void applyStyle(const std::shared_ptr<GraphicsObject>& s,
                        const AttrMap& a) {
-  s->setFillColor(rebuildColor(a, "fill"));
-  s->setStrokeColor(rebuildColor(a, "stroke"));
-  s->setStrokeWidth(num(a, "stroke-width", 1.0));
+  s->setFillColor(rebuildColor(a, AttrKey::Fill, AttrKey::FillOpacity));
+  s->setStrokeColor(rebuildColor(a, AttrKey::Stroke, AttrKey::StrokeOpacity));
+  s->setStrokeWidth(num(a, AttrKey::StrokeWidth, 1.0));
 }
 
 // parses a rect tag, creating either a Rectangle or RoundedRectangle
 // depending on presence of rx/ry attributes, and applies styles
 void parseRect(const AttrMap& a, ShapeVec& out) {
-  double x = num(a, "x"), y = num(a, "y");
-  double w = num(a, "width"), h = num(a, "height");
-  double rrx = num(a, "rx"), rry = num(a, "ry");
+  double x = num(a, AttrKey::X), y = num(a, AttrKey::Y);
+  double w = num(a, AttrKey::Width), h = num(a, AttrKey::Height);
+  double rrx = num(a, AttrKey::Rx), rry = num(a, AttrKey::Ry);
   if (rrx > 0 || rry > 0) {
-    auto s = std::make_shared<RoundedRectangle>(x, y, w, h, rrx, rry);
+    auto s = allocateShape<RoundedRectangle>(x, y, w, h, rrx, rry);
     applyStyle(s, a);
     out.push_back(s);
   } else {
-    auto s = std::make_shared<Rectangle>(x, y, w, h);
+    auto s = allocateShape<Rectangle>(x, y, w, h);
     applyStyle(s, a);
     out.push_back(s);
   }
@@ -43,71 +42,70 @@ void parseRect(const AttrMap& a, ShapeVec& out) {
 
 // parse circle tag
 void parseCircle(const AttrMap& a, ShapeVec& out) {
-  auto s = std::make_shared<Circle>(num(a, "cx"), num(a, "cy"), num(a, "r"));
+  auto s = allocateShape<Circle>(num(a, AttrKey::Cx), num(a, AttrKey::Cy),
+                                    num(a, AttrKey::R));
   applyStyle(s, a);
   out.push_back(s);
 }
 
 // parse ellipse tag into circle class with separate rx ry
 void parseEllipse(const AttrMap& a, ShapeVec& out) {
-  auto s = std::make_shared<Circle>(num(a, "cx"), num(a, "cy"), num(a, "rx"),
-                                    num(a, "ry"));
+  auto s = allocateShape<Circle>(num(a, AttrKey::Cx), num(a, AttrKey::Cy),
+                                    num(a, AttrKey::Rx), num(a, AttrKey::Ry));
   applyStyle(s, a);
   out.push_back(s);
 }
 
 // parse line tag
 void parseLine(const AttrMap& a, ShapeVec& out) {
-  auto s = std::make_shared<Line>(num(a, "x1"), num(a, "y1"), num(a, "x2"),
-                                  num(a, "y2"));
+  auto s = allocateShape<Line>(num(a, AttrKey::X1), num(a, AttrKey::Y1),
+                                  num(a, AttrKey::X2), num(a, AttrKey::Y2));
   applyStyle(s, a);
   out.push_back(s);
 }
 
 // parse text tag and preserve font and fill details
-void parseText(const AttrMap& a, const std::string& raw, ShapeVec& out) {
-  auto s =
-      std::make_shared<TextShape>(num(a, "x"), num(a, "y"), unescapeXml(raw));
-  std::string sp = rebuildColor(a, "stroke");
-  std::string fp = rebuildColor(a, "fill");
-  bool hasStroke = a.find("stroke") != a.end();
+void parseText(const AttrMap& a, std::string_view raw, ShapeVec& out) {
+  auto s = allocateShape<TextShape>(num(a, AttrKey::X), num(a, AttrKey::Y),
+                                       unescapeXml(raw));
+  ShapeColor sp = rebuildColor(a, AttrKey::Stroke, AttrKey::StrokeOpacity);
+  ShapeColor fp = rebuildColor(a, AttrKey::Fill, AttrKey::FillOpacity);
+  bool hasStroke = a.find(AttrKey::Stroke) != nullptr;
   s->setStrokeColor(hasStroke ? sp : fp);
-  std::string hl = str(a, "data-highlight-fill");
-  s->setFillColor(hl.empty() ? fp : hl);
-  s->setStrokeWidth(num(a, "stroke-width", 1.0));
-  std::string ff = str(a, "font-family");
-  if (!ff.empty()) s->setFontFamily(ff);
-  s->setFontSize(static_cast<int>(num(a, "font-size", 16.0)));
+  std::string_view hl = str(a, AttrKey::DataHighlightFill);
+  s->setFillColor(hl.empty() ? fp : ShapeColor::fromString(std::string(hl)));
+  s->setStrokeWidth(num(a, AttrKey::StrokeWidth, 1.0));
+  std::string_view ff = str(a, AttrKey::FontFamily);
+  if (!ff.empty()) s->setFontFamily(std::string(ff));
+  s->setFontSize(static_cast<int>(num(a, AttrKey::FontSize, 16.0)));
   out.push_back(s);
 }
 
 // parse polyline when tagged as freehand
 void parsePolyline(const AttrMap& a, ShapeVec& out) {
-  if (str(a, "data-shape") != "freehand") return;
-  auto fh = std::make_shared<Freehand>();
-  std::istringstream iss(str(a, "points"));
-  std::string pair;
-  while (iss >> pair) {
-    size_t comma = pair.find(',');
-    if (comma != std::string::npos) {
-      fh->addPoint(std::stod(pair.substr(0, comma)),
-                   std::stod(pair.substr(comma + 1)));
-    }
-  }
-  fh->setStrokeColor(rebuildColor(a, "stroke"));
-  fh->setStrokeWidth(num(a, "stroke-width", 1.0));
+  if (str(a, AttrKey::DataShape) != "freehand") return;
+  auto fh = allocateShape<Freehand>();
+
+  // each exported point takes about 20 bytes of text, reserving from the
+  // text size keeps long strokes from regrowing the vector
+  std::string_view pts = str(a, AttrKey::Points);
+  PointBuffer points(shapeMemory());
+  points.reserve(pts.size() / 16);
+  parsePointList(pts, points);
+  fh->setPoints(std::move(points));
+  fh->setStrokeColor(rebuildColor(a, AttrKey::Stroke, AttrKey::StrokeOpacity));
+  fh->setStrokeWidth(num(a, AttrKey::StrokeWidth, 1.0));
   out.push_back(fh);
 }
 
 // parse polygon when tagged as hexagon
 void parsePolygon(const AttrMap& a, ShapeVec& out) {
-  if (str(a, "data-shape") != "hexagon") return;
-  auto h = std::make_shared<Hexagon>(num(a, "data-cx"), num(a, "data-cy"),
-                                     num(a, "data-rx"), num(a, "data-ry"));
-  if (str(a, "data-orientation") == "pointy") h->setPointyTop(true);
-  h->setFillColor(rebuildColor(a, "fill"));
-  h->setStrokeColor(rebuildColor(a, "stroke"));
-  h->setStrokeWidth(num(a, "stroke-width", 1.0));
+  if (str(a, AttrKey::DataShape) != "hexagon") return;
+  auto h = allocateShape<Hexagon>(
+      num(a, AttrKey::DataCx), num(a, AttrKey::DataCy), num(a, AttrKey::DataRx),
+      num(a, AttrKey::DataRy));
+  if (str(a, AttrKey::DataOrientation) == "pointy") h->setPointyTop(true);
+  applyStyle(h, a);
   out.push_back(h);
 }
 
@@ -2,76 +2,74 @@
 // implementation for svg parser utils
 
 #include <QColor>
+#include <charconv>
 
 #include "parse/svg_parser_internal.h"
 
 namespace SvgParser {
 
-// parse attributes from one xml tag text
-AttrMap parseAttributes(const std::string& tag) {
-  AttrMap attrs;
-  size_t pos = 0;
-  while (pos < tag.size()) {
-    while (pos < tag.size() && (tag[pos] == ' ' || tag[pos] == '/')) pos++;
-    size_t eq = tag.find('=', pos);
-    if (eq == std::string::npos) break;
-    std::string key = tag.substr(pos, eq - pos);
-    while (!key.empty() && key.back() == ' ') key.pop_back();
-    size_t q1 = tag.find('"', eq);
-    if (q1 == std::string::npos) break;
-    q1++;
-    size_t q2 = tag.find('"', q1);
-    if (q2 == std::string::npos) break;
-    attrs[key] = tag.substr(q1, q2 - q1);
-    pos = q2 + 1;
-  }
-  return attrs;
+// from_chars does not skip leading blanks or a plus sign like stod did
+double toNumber(std::string_view text, double fallback) {
+  size_t start = text.find_first_not_of(" \t\n\r");
+  if (start == std::string_view::npos) return fallback;
+  if (text[start] == '+') start++;
+  double value = 0;
+  auto res =
+      std::from_chars(text.data() + start, text.data() + text.size(), value);
+  return res.ec == std::errc() ? value : fallback;
 }
 
 // parse number attribute with fallback
-double num(const AttrMap& m, const std::string& key, double fallback) {
-  auto it = m.find(key);
-  if (it == m.end()) return fallback;
-  try {
-    return std::stod(it->second);
-  } catch (...) {
-    return fallback;
-  }
+double num(const AttrMap& m, AttrKey key, double fallback) {
+  const std::string_view* v = m.find(key);
+  return v ? toNumber(*v, fallback) : fallback;
 }
 
 // parse string attribute with fallback
-std::string str(const AttrMap& m, const std::string& key,
-                const std::string& fallback) {
-  auto it = m.find(key);
-  return (it != m.end()) ? it->second : fallback;
+std::string_view str(const AttrMap& m, AttrKey key,
+                     std::string_view fallback) {
+  const std::string_view* v = m.find(key);
+  return v ? *v : fallback;
 }
 
-// convert escaped xml back to plain text
-std::string unescapeXml(std::string s) {
-  auto rep = [&](const std::string& from, const std::string& to) {
-    size_t p = 0;
-    while ((p = s.find(from, p)) != std::string::npos) {
-      s.replace(p, from.size(), to);
-      p += to.size();
-    }
+// convert escaped xml back to plain text in a single pass
+std::string unescapeXml(std::string_view s) {
+  static constexpr std::pair<std::string_view, char> kEntities[] = {
+      {"&lt;", '<'},    {"&gt;", '>'},   {"&quot;", '"'},
+      {"&apos;", '\''}, {"&amp;", '&'},
   };
-  rep("&lt;", "<");
-  rep("&gt;", ">");
-  rep("&quot;", "\"");
-  rep("&apos;", "'");
-  rep("&amp;", "&");
-  return s;
+  std::string out;
+  out.reserve(s.size());
+  size_t pos = 0;
+  while (pos < s.size()) {
+    size_t amp = s.find('&', pos);
+    if (amp == std::string_view::npos) amp = s.size();
+    out.append(s.data() + pos, amp - pos);
+    pos = amp;
+    if (pos == s.size()) break;
+
+    // unknown entities are kept as written
+    bool matched = false;
+    for (const auto& [entity, ch] : kEntities) {
+      if (s.compare(pos, entity.size(), entity) == 0) {
+        out += ch;
+        pos += entity.size();
+        matched = true;
+        break;
+      }
+    }
+    if (!matched) out += s[pos++];
+  }
+  return out;
 }
 
 // rebuild colour with opacity from colour and opacity attributes
-std::string rebuildColor(const AttrMap& m, const std::string& prefix) {
-  std::string colorStr = str(m, prefix, "black");
-  if (colorStr == "none") return "transparent";
-  double opacity = num(m, prefix + "-opacity", 1.0);
-  QColor c(colorStr.c_str());
-  if (!c.isValid()) return colorStr;
-  c.setAlphaF(opacity);
-  return c.name(QColor::HexArgb).toStdString();
+ShapeColor rebuildColor(const AttrMap& m, AttrKey color, AttrKey opacity) {
+  ShapeColor c = ShapeColor::fromString(std::string(str(m, color, "black")));
+  if (c.none) return c;
+  QColor q = c.toQColor();
+  q.setAlphaF(num(m, opacity, 1.0));
+  return ShapeColor::fromQColor(q);
 }
 
 }  // namespace SvgParser
@@ -0,0 +1,134 @@
+// svg_point_list.cpp
+// decodes svg points attributes using simd classified character masks
+
+#include <QPointF>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+#include "parse/char_classify.h"
+#include "parse/svg_parser_internal.h"
+
+namespace SvgParser {
+
+namespace {
+
+// walks text in 64 byte blocks, classifying each block once
+class CharScanner {
+ public:
+  CharScanner(std::string_view text, ClassifyFn classify)
+      : text(text), classify(classify) {}
+
+  size_t skipSeparators(size_t from) {
+    return skip(from, &CharMasks::separator);
+  }
+  size_t skipDigits(size_t from) { return skip(from, &CharMasks::digit); }
+
+ private:
+  std::string_view text;
+  ClassifyFn classify;
+  size_t base = SIZE_MAX;
+  CharMasks masks;
+
+  // first position at or after from whose byte is not in the class
+  size_t skip(size_t from, uint64_t CharMasks::*cls) {
+    while (from < text.size()) {
+      size_t block = from & ~size_t(63);
+      if (block != base) load(block);
+      uint64_t open = ~(masks.*cls) >> (from - block);
+      if (open) return std::min(from + __builtin_ctzll(open), text.size());
+      from = block + 64;
+    }
+    return text.size();
+  }
+
+  // the last partial block is padded with a byte that is in no class
+  void load(size_t block) {
+    base = block;
+    if (block + 64 <= text.size()) {
+      masks = classify(text.data() + block);
+      return;
+    }
+    char pad[64];
+    std::memset(pad, 0, sizeof(pad));
+    std::memcpy(pad, text.data() + block, text.size() - block);
+    masks = classify(pad);
+  }
+};
+
+// exact powers of ten, a double product or quotient with these is correctly
+// rounded while the mantissa stays below 2^53
+const double kPow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                         1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                         1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+// eight ascii digits to their value with three multiplies (little endian)
+uint64_t eightDigits(const char* p) {
+  uint64_t v;
+  std::memcpy(&v, p, 8);
+  v = (v & 0x0F0F0F0F0F0F0F0F) * 2561 >> 8;
+  v = (v & 0x00FF00FF00FF00FF) * 6553601 >> 16;
+  return (v & 0x0000FFFF0000FFFF) * 42949672960001 >> 32;
+}
+#endif
+
+uint64_t appendDigits(uint64_t acc, const char* p, size_t n) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  for (; n >= 8; n -= 8, p += 8) acc = acc * 100000000 + eightDigits(p);
+#endif
+  for (; n > 0; n--, p++) acc = acc * 10 + uint64_t(*p - '0');
+  return acc;
+}
+
+// plain decimals like the ones this app writes take the fast path, anything
+// with an exponent or too many digits goes through from_chars
+bool parseNumber(std::string_view text, CharScanner& scan, size_t& pos,
+                 double& value) {
+  size_t i = pos;
+  bool neg = text[i] == '-';
+  if (neg || text[i] == '+') i++;
+  size_t intEnd = scan.skipDigits(i);
+  size_t fracBegin = intEnd, end = intEnd;
+  if (end < text.size() && text[end] == '.') {
+    fracBegin = end + 1;
+    end = scan.skipDigits(fracBegin);
+  }
+  size_t intDigits = intEnd - i, fracDigits = end - fracBegin;
+  bool exponent = end < text.size() && (text[end] | 0x20) == 'e';
+  if (intDigits + fracDigits > 0 && intDigits + fracDigits <= 19 &&
+      fracDigits <= 22 && !exponent) {
+    uint64_t m = appendDigits(0, text.data() + i, intDigits);
+    m = appendDigits(m, text.data() + fracBegin, fracDigits);
+    if (m <= (uint64_t(1) << 53)) {
+      value = double(m) / kPow10[fracDigits];
+      if (neg) value = -value;
+      pos = end;
+      return true;
+    }
+  }
+  const char* first = text.data() + (text[pos] == '+' ? pos + 1 : pos);
+  auto res = std::from_chars(first, text.data() + text.size(), value);
+  if (res.ec != std::errc()) return false;
+  pos = res.ptr - text.data();
+  return true;
+}
+
+}  // namespace
+
+size_t parsePointList(std::string_view text, PointBuffer& out) {
+  static const ClassifyFn classify = selectClassifier();
+  CharScanner scan(text, classify);
+  size_t pos = 0, added = 0;
+  double x = 0, y = 0;
+  while ((pos = scan.skipSeparators(pos)) < text.size()) {
+    if (!parseNumber(text, scan, pos, x)) break;
+    pos = scan.skipSeparators(pos);
+    if (pos >= text.size() || !parseNumber(text, scan, pos, y)) break;
+    out.emplace_back(x, y);
+    added++;
+  }
+  return added;
+}
+
+}  // namespace SvgParser
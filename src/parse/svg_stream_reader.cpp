@@ -0,0 +1,99 @@
+// svg_stream_reader.cpp
+// block wise svg reading with carry over of incomplete elements
+
+#include "parse/svg_stream_reader.h"
+
+#include <algorithm>
+#include <string_view>
+
+#include "parse/svg_parser.h"
+
+namespace SvgParser {
+
+namespace {
+// large enough that the chunked parallel parse still pays off per block
+const size_t kBlockBytes = 4 * 1024 * 1024;
+
+bool isTextOpen(std::string_view tag) {
+  if (tag.substr(0, 5) != "<text") return false;
+  char c = tag[5];
+  return c == '>' || c == '/' || c == ' ' || c == '\t' || c == '\r' ||
+         c == '\n';
+}
+}  // namespace
+
+// walk the bytes added since the last block once, so an element longer
+// than a block costs linear time however many blocks it spans
+// the cut is the start of the last element that may still be incomplete
+// a text element is cut before its start until its </text> arrived, the
+// same close tag parseRange pairs it with, so its children stay with it
+void StreamReader::scanForCut() {
+  std::string_view buf(pending);
+  size_t i = scanned;
+  while ((i = buf.find('<', i)) != std::string_view::npos) {
+    // a tag split by the block end is looked at again with the next block
+    if (buf.size() - i < 7) break;
+    if (inText) {
+      if (buf.substr(i, 7) == "</text>") inText = false;
+    } else if (buf[i + 1] != '/') {
+      cut = i;
+      inText = isTextOpen(buf.substr(i, 6));
+    }
+    i++;
+  }
+  scanned = i == std::string_view::npos ? buf.size() : i;
+}
+
+StreamReader::StreamReader(const std::string& path, double simplifyTolerance)
+    : file(path, std::ios::binary | std::ios::ate),
+      tolerance(simplifyTolerance) {
+  if (!file.is_open()) {
+    done = true;
+    return;
+  }
+  std::streamoff size = file.tellg();
+  fileSize = size > 0 ? static_cast<size_t>(size) : 0;
+  file.seekg(0);
+}
+
+bool StreamReader::isOpen() const { return file.is_open(); }
+bool StreamReader::atEnd() const { return done; }
+size_t StreamReader::bytesRead() const { return consumed; }
+size_t StreamReader::totalBytes() const { return fileSize; }
+size_t StreamReader::removedPoints() const { return removed; }
+
+bool StreamReader::next(std::vector<std::shared_ptr<GraphicsObject>>& out) {
+  if (done) return false;
+  size_t keep = pending.size();
+  pending.resize(keep + kBlockBytes);
+  file.read(pending.data() + keep, kBlockBytes);
+  size_t got = static_cast<size_t>(file.gcount());
+  pending.resize(keep + got);
+  consumed += got;
+  bool eof = got < kBlockBytes;
+
+  // parse everything up to the last element that may continue in the next
+  // block, at the end of the file the whole remainder is parsed
+  scanForCut();
+  size_t end = eof ? pending.size() : cut;
+  if (end > 0) {
+    size_t dropped = 0;
+    auto shapes = parse(std::string_view(pending).substr(0, end), tolerance,
+                        &dropped);
+    removed += dropped;
+    out.insert(out.end(), std::make_move_iterator(shapes.begin()),
+               std::make_move_iterator(shapes.end()));
+    pending.erase(0, end);
+    scanned -= std::min(scanned, end);
+    cut = 0;
+  }
+
+  if (eof) {
+    done = true;
+    pending.clear();
+    pending.shrink_to_fit();
+  }
+  return true;
+}
+
+}  // namespace SvgParser
@@ -0,0 +1,94 @@
+// binary_writer.cpp
+// lays out shape records, points and strings as a native document file
+
+#include <cstring>
+
+#include "shapes/binary_format.h"
+#include "shapes/graphics_object.h"
+#include "shapes/shape_style.h"
+
+namespace BinaryFormat {
+
+bool isBinaryPath(const std::string& path) {
+  size_t n = sizeof(kExtension) - 1;
+  return path.size() >= n &&
+         path.compare(path.size() - n, n, kExtension) == 0;
+}
+
+// argb, or the offset of the name for colours qt does not know
+uint32_t Writer::colorValue(const ShapeColor& color, uint8_t namedFlag,
+                            uint8_t& flags) {
+  if (!color.named || strings.size() > UINT32_MAX) return color.argb;
+  flags |= namedFlag;
+  uint64_t offset = addString(color.name());
+  strings += '\0';
+  return static_cast<uint32_t>(offset);
+}
+
+ShapeRecord& Writer::add(ShapeType type, const GraphicsObject& shape) {
+  ShapeRecord rec{};
+  rec.type = static_cast<uint8_t>(type);
+  if (shape.getFill().none) rec.flags |= kFillNone;
+  if (shape.getStroke().none) rec.flags |= kStrokeNone;
+  rec.fill = colorValue(shape.getFill(), kFillNamed, rec.flags);
+  rec.stroke = colorValue(shape.getStroke(), kStrokeNamed, rec.flags);
+  rec.strokeWidth = shape.getStrokeWidth();
+  records.push_back(rec);
+  return records.back();
+}
+
+uint64_t Writer::addPoints(const QPointF* pts, size_t count) {
+  uint64_t first = points.size();
+  points.insert(points.end(), pts, pts + count);
+  return first;
+}
+
+uint64_t Writer::addString(std::string_view text) {
+  uint64_t first = strings.size();
+  strings += text;
+  return first;
+}
+
+std::string Writer::finish(int width, int height) const {
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+  return {};
+#endif
+  size_t typeCount = static_cast<size_t>(ShapeType::Count);
+  FileHeader h{};
+  std::memcpy(h.magic, kMagic, sizeof(kMagic));
+  h.version = kVersion;
+  h.width = width;
+  h.height = height;
+  h.typeCount = static_cast<uint32_t>(typeCount);
+  h.recordSize = sizeof(ShapeRecord);
+  h.shapeCount = records.size();
+  h.typeTableOffset = sizeof(FileHeader);
+  h.recordsOffset = h.typeTableOffset + typeCount * sizeof(TypeEntry);
+  h.pointsOffset = h.recordsOffset + records.size() * sizeof(ShapeRecord);
+  h.pointCount = points.size();
+  h.stringsOffset = h.pointsOffset + points.size() * sizeof(QPointF);
+  h.stringBytes = strings.size();
+
+  // every section size is a multiple of 8 so the sections stay aligned
+  std::string out(h.stringsOffset + strings.size(), '\0');
+  char* base = &out[0];
+  std::memcpy(base, &h, sizeof(h));
+  for (size_t i = 0; i < typeCount; i++) {
+    TypeEntry entry{};
+    entry.id = static_cast<uint8_t>(i);
+    std::strncpy(entry.name, shapeTypeName(static_cast<ShapeType>(i)),
+                 sizeof(entry.name) - 1);
+    std::memcpy(base + h.typeTableOffset + i * sizeof(TypeEntry), &entry,
+                sizeof(entry));
+  }
+  if (!records.empty())
+    std::memcpy(base + h.recordsOffset, records.data(),
+                records.size() * sizeof(ShapeRecord));
+  if (!points.empty())
+    std::memcpy(base + h.pointsOffset, points.data(),
+                points.size() * sizeof(QPointF));
+  std::memcpy(base + h.stringsOffset, strings.data(), strings.size());
+  return out;
+}
+
+}  // namespace BinaryFormat
@@ -3,9 +3,16 @@
 
 #include "shapes/circle.h"
 
+#include <algorithm>
 #include <cmath>
+#include <iterator>
 #include <string>
 
+#include "shapes/binary_format.h"
+#include "shapes/geo_kernels.h"
+#include "shapes/shape_pool.h"
+#include "shapes/svg_writer.h"
+
 // constructor for regular circle stores equal radii on initialisation
 Circle::Circle(double x, double y, double r) : cx(x), cy(y), rx(r), ry(r) {
   this->width = 2 * rx;
@@ -21,35 +28,40 @@ Circle::Circle(double x, double y, double rx, double ry)
 
 // draw shape using fill and stroke properties
 void Circle::draw(QPainter& painter) const {
-  QPen pen(QColor(strokeColor.c_str()));
-  pen.setWidthF(strokeWidth);
-  painter.setPen(pen);
-
-  if (fillColor == "none") {
-    painter.setBrush(Qt::NoBrush);
-  } else {
-    painter.setBrush(QBrush(QColor(fillColor.c_str())));
-  }
+  painter.setPen(strokePen);
+  painter.setBrush(fillBrush);
 
   painter.drawEllipse(QPointF(cx, cy), rx, ry);
 }
 
 // convert object state to svg ellipse tag
-std::string Circle::toSVG() const {
-  return "<ellipse cx=\"" + std::to_string(cx) + "\" " + "cy=\"" +
-         std::to_string(cy) + "\" " + "rx=\"" + std::to_string(rx) + "\" " +
-         "ry=\"" + std::to_string(ry) + "\" " +
-         svgColorAttr("stroke", strokeColor) + " " + "stroke-width=\"" +
-         std::to_string(strokeWidth) + "\" " + svgColorAttr("fill", fillColor) +
-         " />";
+void Circle::writeSVG(SvgWriter& out) const {
+  out.raw("<ellipse")
+      .attr("cx", cx)
+      .attr("cy", cy)
+      .attr("rx", rx)
+      .attr("ry", ry);
+  writeStrokeAndFill(out);
+  out.raw(" />");
+}
+
+// fixed size record, see binary_format.h
+void Circle::writeBinary(BinaryFormat::Writer& out) const {
+  auto& rec = out.add(ShapeType::Circle, *this);
+  double geom[] = {cx, cy, rx, ry};
+  std::copy(std::begin(geom), std::end(geom), rec.geom);
+}
+
+// shape back from its record, the reader checked the data range
+std::shared_ptr<GraphicsObject> Circle::fromRecord(
+    const BinaryFormat::RecordView& in) {
+  const double* g = in.rec.geom;
+  return allocateShape<Circle>(g[0], g[1], g[2], g[3]);
 }
 
 // hit test using normalized ellipse equation
 bool Circle::contains(double x, double y) const {
-  if (rx <= 0 || ry <= 0) return false;
-  double dx = (x - cx) / rx;
-  double dy = (y - cy) / ry;
-  return (dx * dx + dy * dy) <= 1.0;
+  return GeoKernels::ellipseHit(cx, cy, rx, ry, x, y);
 }
 
 // axis aligned bounding box for selection and handles
@@ -57,6 +69,12 @@ QRectF Circle::boundingBox() const {
   return QRectF(cx - rx, cy - ry, 2 * rx, 2 * ry);
 }
 
+// geometry accessors
+double Circle::getCx() const { return cx; }
+double Circle::getCy() const { return cy; }
+double Circle::getRx() const { return rx; }
+double Circle::getRy() const { return ry; }
+
 // update both radii for circle mode
 void Circle::setRadius(double r) {
   rx = r;
@@ -87,10 +105,8 @@ void Circle::moveBy(double dx, double dy) {
 
 // clone with style fields copied for clipboard and commands
 std::shared_ptr<GraphicsObject> Circle::clone() const {
-  auto copy = std::make_shared<Circle>(cx, cy, rx, ry);
-  copy->setFillColor(getFillColor());
-  copy->setStrokeColor(getStrokeColor());
-  copy->setStrokeWidth(getStrokeWidth());
+  auto copy = allocateShape<Circle>(cx, cy, rx, ry);
+  copy->copyStyleFrom(*this);
   return copy;
 }
 
@@ -5,82 +5,116 @@
 
 #include <QPainterPath>
 #include <algorithm>
-#include <cmath>
+#include <cstring>
+
+#include "shapes/binary_format.h"
+#include "shapes/geo_kernels.h"
+#include "shapes/svg_writer.h"
 
 // default freehand style is no fill, black stroke, width one
 Freehand::Freehand() {
-  fillColor = "none";
-  strokeColor = "black";
-  strokeWidth = 1;
+  setFillColor(ShapeColor());
+  setStrokeColor(ShapeColor{qRgba(0, 0, 0, 255), false});
+  setStrokeWidth(1);
+  strokePen.setCapStyle(Qt::RoundCap);
+  strokePen.setJoinStyle(Qt::RoundJoin);
 }
 
-// append sampled point to the polyline
-void Freehand::addPoint(double x, double y) { points.emplace_back(x, y); }
+// append sampled point to the polyline, extending the cached path in place
+void Freehand::addPoint(double x, double y) {
+  points.emplace_back(x, y);
+  bvhValid = false;
+  if (extentValid) {
+    if (points.size() == 1) extent = Extent{x, y, x, y};
+    extent.minX = std::min(extent.minX, x);
+    extent.minY = std::min(extent.minY, y);
+    extent.maxX = std::max(extent.maxX, x);
+    extent.maxY = std::max(extent.maxY, y);
+  }
+  if (!pathValid) return;
+  if (points.size() == 1)
+    path.moveTo(points.back());
+  else
+    path.lineTo(points.back());
+}
 
 // return points for drawing and resize logic
-const std::vector<QPointF>& Freehand::getPoints() const { return points; }
+const PointBuffer& Freehand::getPoints() const { return points; }
+
+// a buffer from another resource is copied into the pool on assignment
+void Freehand::setPoints(PointBuffer pts) {
+  points = std::move(pts);
+  geometryChanged();
+}
+
+void Freehand::geometryChanged() {
+  pathValid = false;
+  extentValid = false;
+  bvhValid = false;
+}
+
+// rebuild the path only after an edit that could not update it in place
+const QPainterPath& Freehand::getPath() const {
+  if (!pathValid) {
+    path = QPainterPath();
+    if (!points.empty()) path.moveTo(points[0]);
+    for (size_t i = 1; i < points.size(); i++) path.lineTo(points[i]);
+    pathValid = true;
+  }
+  return path;
+}
 
 // draw polyline path when at least two points exist
 // to prevent single clicks
 void Freehand::draw(QPainter& painter) const {
   if (points.size() < 2) return;
-  QPen pen(QColor(strokeColor.c_str()));
-  pen.setWidthF(strokeWidth);
-  pen.setCapStyle(Qt::RoundCap);
-  pen.setJoinStyle(Qt::RoundJoin);
-  painter.setPen(pen);
+  painter.setPen(strokePen);
   painter.setBrush(Qt::NoBrush);
-
-  QPainterPath path;
-  path.moveTo(points[0]);
-  for (size_t i = 1; i < points.size(); i++) {
-    path.lineTo(points[i]);
-  }
-  painter.drawPath(path);
+  painter.drawPath(getPath());
 }
 
-// compute tight bounding box around all points
+// tight bounding box around all points, rescanned only after a rewrite
 QRectF Freehand::boundingBox() const {
   if (points.empty()) return QRectF(0, 0, 0, 0);
-  double minX = points[0].x(), maxX = minX;
-  double minY = points[0].y(), maxY = minY;
-  for (auto& pt : points) {
-    minX = std::min(minX, pt.x());
-    maxX = std::max(maxX, pt.x());
-    minY = std::min(minY, pt.y());
-    maxY = std::max(maxY, pt.y());
+  if (!extentValid) {
+    auto e = GeoKernels::kernels().extent(points.data(), points.size());
+    extent = Extent{e.minX, e.minY, e.maxX, e.maxY};
+    extentValid = true;
   }
-  return QRectF(minX, minY, maxX - minX, maxY - minY);
+  return QRectF(extent.minX, extent.minY, extent.maxX - extent.minX,
+                extent.maxY - extent.minY);
 }
 
-// hit test by checking distance to every segment
-bool Freehand::contains(double x, double y) const {
-  // check if x,y is close to any segment of the polyline
-  const double tolerance = 6.0;
-  for (size_t i = 1; i < points.size(); i++) {
-    double x1 = points[i - 1].x(), y1 = points[i - 1].y();
-    double x2 = points[i].x(), y2 = points[i].y();
-    double dx = x2 - x1, dy = y2 - y1;
-    double lenSq = dx * dx + dy * dy;
-    double t = (lenSq > 0) ? ((x - x1) * dx + (y - y1) * dy) / lenSq : 0;
-    t = std::max(0.0, std::min(1.0, t));
-    double px = x1 + t * dx, py = y1 + t * dy;
-    double dist = std::sqrt((x - px) * (x - px) + (y - py) * (y - py));
-    if (dist <= tolerance) return true;
+// polyline with freehand marker attribute
+void Freehand::writeSVG(SvgWriter& out) const {
+  if (points.empty()) return;
+  out.raw("<polyline data-shape=\"freehand\" points=\"");
+  for (size_t i = 0; i < points.size(); i++) {
+    if (i > 0) out.raw(" ");
+    out.point(points[i].x(), points[i].y());
   }
-  return false;
+  out.raw("\"")
+      .color("stroke", strokeColor)
+      .attr("stroke-width", strokeWidth)
+      .raw(" fill=\"none\" stroke-linecap=\"round\" "
+           "stroke-linejoin=\"round\" />");
 }
 
-// toSVG polyline with freehand marker attribute
-std::string Freehand::toSVG() const {
-  if (points.empty()) return "";
-  std::string pts;
-  for (size_t i = 0; i < points.size(); i++) {
-    if (i > 0) pts += " ";
-    pts += std::to_string(points[i].x()) + "," + std::to_string(points[i].y());
-  }
-  return "<polyline data-shape=\"freehand\" points=\"" + pts + "\" " +
-         svgColorAttr("stroke", strokeColor) + " stroke-width=\"" +
-         std::to_string(strokeWidth) + "\" " + "fill=\"none\" " +
-         "stroke-linecap=\"round\" stroke-linejoin=\"round\" />";
+// fixed size record, see binary_format.h
+void Freehand::writeBinary(BinaryFormat::Writer& out) const {
+  auto& rec = out.add(ShapeType::Freehand, *this);
+  rec.dataOffset = out.addPoints(points.data(), points.size());
+  rec.dataCount = points.size();
+}
+
+// shape back from its record, the reader checked the data range
+std::shared_ptr<GraphicsObject> Freehand::fromRecord(
+    const BinaryFormat::RecordView& in) {
+  PointBuffer pts(in.rec.dataCount, shapeMemory());
+  std::memcpy(static_cast<void*>(pts.data()),
+              in.points + in.rec.dataOffset * sizeof(QPointF),
+              in.rec.dataCount * sizeof(QPointF));
+  auto fh = allocateShape<Freehand>();
+  fh->setPoints(std::move(pts));
+  return fh;
 }
@@ -0,0 +1,117 @@
+// freehand_bvh.cpp
+// segment bounding volume hierarchy used for freehand hit testing
+
+#include <algorithm>
+
+#include "shapes/freehand.h"
+#include "shapes/geo_kernels.h"
+
+namespace {
+// a leaf is two avx2 or four sse2 kernel steps
+const int kLeafSegments = 8;
+// hit distance around the stroke centre line
+const double kHitTolerance = 6.0;
+}  // namespace
+
+double Freehand::segmentDistSq(const QPointF& p, const QPointF& a,
+                               const QPointF& b) {
+  return GeoKernels::segmentDistSq(a.x(), a.y(), b.x(), b.y(), p.x(), p.y());
+}
+
+// split segments at the median of their midpoints along the wider axis
+int Freehand::buildBvhNode(int first, int count) const {
+  BvhNode node;
+  const QPointF& p0 = points[bvhOrder[first]];
+  node.box = Extent{p0.x(), p0.y(), p0.x(), p0.y()};
+  for (int i = first; i < first + count; i++) {
+    for (int k = 0; k < 2; k++) {
+      const QPointF& p = points[bvhOrder[i] + k];
+      node.box.minX = std::min(node.box.minX, p.x());
+      node.box.minY = std::min(node.box.minY, p.y());
+      node.box.maxX = std::max(node.box.maxX, p.x());
+      node.box.maxY = std::max(node.box.maxY, p.y());
+    }
+  }
+  int index = static_cast<int>(bvh.size());
+  bvh.push_back(node);
+  if (count <= kLeafSegments) {
+    bvh[index].first = first;
+    bvh[index].count = count;
+    return index;
+  }
+
+  bool alongX = node.box.maxX - node.box.minX >= node.box.maxY - node.box.minY;
+  auto mid = [this, alongX](int s) {
+    return alongX ? points[s].x() + points[s + 1].x()
+                  : points[s].y() + points[s + 1].y();
+  };
+  int half = count / 2;
+  std::nth_element(bvhOrder.begin() + first, bvhOrder.begin() + first + half,
+                   bvhOrder.begin() + first + count,
+                   [&mid](int a, int b) { return mid(a) < mid(b); });
+  int left = buildBvhNode(first, half);
+  int right = buildBvhNode(first + half, count - half);
+  bvh[index].left = left;
+  bvh[index].right = right;
+  return index;
+}
+
+void Freehand::buildBvh() const {
+  bvh.clear();
+  bvhOrder.clear();
+  int segments = static_cast<int>(points.size()) - 1;
+  if (segments > 0) {
+    bvhOrder.resize(segments);
+    for (int i = 0; i < segments; i++) bvhOrder[i] = i;
+    bvh.reserve(2 * (segments / kLeafSegments + 1));
+    buildBvhNode(0, segments);
+  }
+  leafAx.resize(bvhOrder.size());
+  leafAy.resize(bvhOrder.size());
+  leafBx.resize(bvhOrder.size());
+  leafBy.resize(bvhOrder.size());
+  for (size_t i = 0; i < bvhOrder.size(); i++) {
+    const QPointF& a = points[bvhOrder[i]];
+    const QPointF& b = points[bvhOrder[i] + 1];
+    leafAx[i] = a.x();
+    leafAy[i] = a.y();
+    leafBx[i] = b.x();
+    leafBy[i] = b.y();
+  }
+  bvhValid = true;
+}
+
+// hit test walks only nodes whose padded box holds the point and compares
+// squared distances, so long strokes cost a logarithmic number of checks
+bool Freehand::contains(double x, double y) const {
+  if (points.size() < 2) return false;
+  if (!bvhValid) buildBvh();
+  const double tolSq = kHitTolerance * kHitTolerance;
+  const auto& kernels = GeoKernels::kernels();
+  double dist[kLeafSegments];
+
+  // median splits keep the depth near log2 of the segment count
+  int stack[64];
+  int top = 0;
+  stack[top++] = 0;
+  while (top > 0) {
+    const BvhNode& node = bvh[stack[--top]];
+    const Extent& b = node.box;
+    if (x < b.minX - kHitTolerance || x > b.maxX + kHitTolerance ||
+        y < b.minY - kHitTolerance || y > b.maxY + kHitTolerance)
+      continue;
+    if (node.left < 0) {
+      int f = node.first;
+      auto n = static_cast<size_t>(node.count);
+      GeoKernels::Segments leaf{&leafAx[f], &leafAy[f], &leafBx[f],
+                                &leafBy[f], n};
+      kernels.segmentDistSq(leaf, x, y, dist);
+      for (size_t i = 0; i < n; i++)
+        if (dist[i] <= tolSq) return true;
+      continue;
+    }
+    stack[top++] = node.left;
+    stack[top++] = node.right;
+  }
+  return false;
+}
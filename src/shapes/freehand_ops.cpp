@@ -3,6 +3,7 @@
 // box
 
 #include "shapes/freehand.h"
+#include "shapes/shape_pool.h"
 
 // translate every point by the given offset
 void Freehand::moveBy(double dx, double dy) {
@@ -10,15 +11,34 @@ void Freehand::moveBy(double dx, double dy) {
     pt.setX(pt.x() + dx);
     pt.setY(pt.y() + dy);
   }
+  if (pathValid) path.translate(dx, dy);
+
+  // cached bounds and hierarchy shift with the points
+  auto shift = [dx, dy](Extent& e) {
+    e.minX += dx;
+    e.maxX += dx;
+    e.minY += dy;
+    e.maxY += dy;
+  };
+  if (extentValid) shift(extent);
+  if (bvhValid) {
+    for (auto& node : bvh) shift(node.box);
+    for (size_t i = 0; i < leafAx.size(); i++) {
+      leafAx[i] += dx;
+      leafAy[i] += dy;
+      leafBx[i] += dx;
+      leafBy[i] += dy;
+    }
+  }
 }
 
 // clone freehand with points and style
 std::shared_ptr<GraphicsObject> Freehand::clone() const {
-  auto copy = std::make_shared<Freehand>();
-  copy->points = points;
-  copy->setFillColor(getFillColor());
-  copy->setStrokeColor(getStrokeColor());
-  copy->setStrokeWidth(getStrokeWidth());
+  auto copy = allocateShape<Freehand>();
+  copy->setPoints(PointBuffer(points, shapeMemory()));
+  copy->path = getPath();
+  copy->pathValid = true;
+  copy->copyStyleFrom(*this);
   return copy;
 }
 
@@ -38,4 +58,5 @@ void Freehand::scaleToBox(double left, double top, double right,
     pt.setX(left + tx * (right - left));
     pt.setY(top + ty * (bottom - top));
   }
+  geometryChanged();
 }
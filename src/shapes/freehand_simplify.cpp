@@ -0,0 +1,46 @@
+// freehand_simplify.cpp
+// ramer douglas peucker simplification for freehand strokes
+
+#include <algorithm>
+#include <utility>
+
+#include "shapes/freehand.h"
+
+// drop points that lie within tolerance of the simplified polyline
+// uses an explicit stack so very long strokes cannot overflow recursion
+size_t Freehand::simplify(double tolerance) {
+  if (tolerance <= 0 || points.size() < 3) return 0;
+  double tolSq = tolerance * tolerance;
+  std::vector<char> keep(points.size(), 0);
+  keep.front() = keep.back() = 1;
+
+  std::vector<std::pair<size_t, size_t>> spans{{0, points.size() - 1}};
+  while (!spans.empty()) {
+    auto [first, last] = spans.back();
+    spans.pop_back();
+
+    // farthest point from the chord decides whether the span is split
+    double worst = 0;
+    size_t split = first;
+    for (size_t i = first + 1; i < last; i++) {
+      double d = segmentDistSq(points[i], points[first], points[last]);
+      if (d > worst) {
+        worst = d;
+        split = i;
+      }
+    }
+    if (worst <= tolSq) continue;
+    keep[split] = 1;
+    spans.emplace_back(first, split);
+    spans.emplace_back(split, last);
+  }
+
+  size_t kept = 0;
+  for (size_t i = 0; i < points.size(); i++) {
+    if (keep[i]) points[kept++] = points[i];
+  }
+  size_t removed = points.size() - kept;
+  points.resize(kept);
+  if (removed > 0) geometryChanged();
+  return removed;
+}
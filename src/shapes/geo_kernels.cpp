@@ -0,0 +1,123 @@
+// geo_kernels.cpp
+// scalar reference kernels for hit testing and bounds, and kernel selection
+
+#include "shapes/geo_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "shapes/geo_kernels_internal.h"
+
+namespace GeoKernels {
+
+namespace {
+constexpr double kPi = 3.14159265358979323846;
+
+HexUnit makeHexUnit(bool pointyTop) {
+  HexUnit u;
+  double offset = pointyTop ? (kPi / 6.0) : 0.0;
+  for (int i = 0; i < 6; i++) {
+    double angle = kPi / 180.0 * (60.0 * i) + offset;
+    u.cos[i] = std::cos(angle);
+    u.sin[i] = std::sin(angle);
+  }
+  return u;
+}
+
+// edge crossing rule of QPolygonF::containsPoint, horizontal edges are
+// skipped with the same fuzzy compare
+bool crosses(double x1, double y1, double x2, double y2, double x, double y) {
+  if (std::abs(y1 - y2) * 1000000000000. <=
+      std::min(std::abs(y1), std::abs(y2)))
+    return false;
+  if (y2 < y1) {
+    std::swap(x1, x2);
+    std::swap(y1, y2);
+  }
+  if (!(y >= y1 && y < y2)) return false;
+  return x1 + ((x2 - x1) / (y2 - y1)) * (y - y1) <= x;
+}
+
+Extent extentScalar(const QPointF* points, size_t n) {
+  Extent e{points[0].x(), points[0].y(), points[0].x(), points[0].y()};
+  for (size_t i = 1; i < n; i++) {
+    e.minX = std::min(e.minX, points[i].x());
+    e.maxX = std::max(e.maxX, points[i].x());
+    e.minY = std::min(e.minY, points[i].y());
+    e.maxY = std::max(e.maxY, points[i].y());
+  }
+  return Extent{e.minX + 0.0, e.minY + 0.0, e.maxX + 0.0, e.maxY + 0.0};
+}
+
+void segmentsScalar(const Segments& s, double px, double py, double* out) {
+  for (size_t i = 0; i < s.n; i++)
+    out[i] = segmentDistSq(s.ax[i], s.ay[i], s.bx[i], s.by[i], px, py);
+}
+
+void ellipsesScalar(const Ellipses& e, double x, double y, uint8_t* hits) {
+  for (size_t i = 0; i < e.n; i++)
+    hits[i] = ellipseHit(e.cx[i], e.cy[i], e.rx[i], e.ry[i], x, y);
+}
+
+void hexagonsScalar(const Hexagons& h, double x, double y, uint8_t* hits) {
+  for (size_t i = 0; i < h.n; i++)
+    hits[i] =
+        hexagonHit(h.cx[i], h.cy[i], h.rx[i], h.ry[i], h.pointyTop, x, y);
+}
+}  // namespace
+
+double segmentDistSq(double ax, double ay, double bx, double by, double px,
+                     double py) {
+  double dx = bx - ax, dy = by - ay;
+  double lenSq = dx * dx + dy * dy;
+  double t = lenSq > 0 ? ((px - ax) * dx + (py - ay) * dy) / lenSq : 0.0;
+  t = std::clamp(t, 0.0, 1.0);
+  double ex = px - (ax + t * dx), ey = py - (ay + t * dy);
+  return ex * ex + ey * ey;
+}
+
+bool ellipseHit(double cx, double cy, double rx, double ry, double x,
+                double y) {
+  if (rx <= 0 || ry <= 0) return false;
+  double dx = (x - cx) / rx;
+  double dy = (y - cy) / ry;
+  return (dx * dx + dy * dy) <= 1.0;
+}
+
+bool hexagonHit(double cx, double cy, double rx, double ry, bool pointyTop,
+                double x, double y) {
+  const HexUnit& u = hexUnit(pointyTop);
+  bool inside = false;
+  for (int i = 0; i < 6; i++) {
+    int j = (i + 1) % 6;
+    inside ^= crosses(cx + rx * u.cos[i], cy + ry * u.sin[i],
+                      cx + rx * u.cos[j], cy + ry * u.sin[j], x, y);
+  }
+  return inside;
+}
+
+const HexUnit& hexUnit(bool pointyTop) {
+  static const HexUnit flat = makeHexUnit(false);
+  static const HexUnit pointy = makeHexUnit(true);
+  return pointyTop ? pointy : flat;
+}
+
+const Kernels& scalarKernels() {
+  static const Kernels k{extentScalar, segmentsScalar, ellipsesScalar,
+                         hexagonsScalar};
+  return k;
+}
+
+const Kernels& kernels() {
+  static const Kernels& k = []() -> const Kernels& {
+#ifdef GEO_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return avx2Kernels();
+    if (__builtin_cpu_supports("sse2")) return sse2Kernels();
+#endif
+    return scalarKernels();
+  }();
+  return k;
+}
+
+}  // namespace GeoKernels
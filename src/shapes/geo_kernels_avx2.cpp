@@ -0,0 +1,167 @@
+// geo_kernels_avx2.cpp
+// four lane avx2 versions of the hit test and bounds kernels
+
+#include "shapes/geo_kernels_internal.h"
+
+#ifdef GEO_X86_KERNELS
+#include <immintrin.h>
+
+#define AVX2 __attribute__((target("avx2")))
+
+namespace GeoKernels {
+
+namespace {
+// ordered quiet compares, false for nan like the c++ operators
+AVX2 inline __m256d lt(__m256d a, __m256d b) {
+  return _mm256_cmp_pd(a, b, _CMP_LT_OQ);
+}
+AVX2 inline __m256d le(__m256d a, __m256d b) {
+  return _mm256_cmp_pd(a, b, _CMP_LE_OQ);
+}
+AVX2 inline __m256d ge(__m256d a, __m256d b) {
+  return _mm256_cmp_pd(a, b, _CMP_GE_OQ);
+}
+
+// a where the mask is set, b elsewhere
+AVX2 inline __m256d select(__m256d mask, __m256d a, __m256d b) {
+  return _mm256_blendv_pd(b, a, mask);
+}
+
+AVX2 inline __m256d absPd(__m256d v) {
+  return _mm256_andnot_pd(_mm256_set1_pd(-0.0), v);
+}
+
+AVX2 inline void storeHits(__m256d mask, uint8_t* hits) {
+  int bits = _mm256_movemask_pd(mask);
+  for (int k = 0; k < 4; k++) hits[k] = (bits >> k) & 1;
+}
+
+// each register holds two points, min_pd(p, acc) keeps acc unless p is
+// smaller, like std::min(acc, p)
+AVX2 Extent extentAvx2(const QPointF* points, size_t n) {
+  const double* xy = reinterpret_cast<const double*>(points);
+  __m256d lo0 = _mm256_broadcast_pd(reinterpret_cast<const __m128d*>(xy));
+  __m256d hi0 = lo0, lo1 = lo0, hi1 = lo0;
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d a = _mm256_loadu_pd(xy + 2 * i);
+    __m256d b = _mm256_loadu_pd(xy + 2 * i + 4);
+    lo0 = _mm256_min_pd(a, lo0);
+    hi0 = _mm256_max_pd(a, hi0);
+    lo1 = _mm256_min_pd(b, lo1);
+    hi1 = _mm256_max_pd(b, hi1);
+  }
+  lo0 = _mm256_min_pd(lo1, lo0);
+  hi0 = _mm256_max_pd(hi1, hi0);
+  __m128d lo = _mm_min_pd(_mm256_extractf128_pd(lo0, 1),
+                          _mm256_castpd256_pd128(lo0));
+  __m128d hi = _mm_max_pd(_mm256_extractf128_pd(hi0, 1),
+                          _mm256_castpd256_pd128(hi0));
+  for (; i < n; i++) {
+    __m128d p = _mm_loadu_pd(xy + 2 * i);
+    lo = _mm_min_pd(p, lo);
+    hi = _mm_max_pd(p, hi);
+  }
+  // adding zero turns a negative zero positive like the scalar kernel
+  lo = _mm_add_pd(lo, _mm_setzero_pd());
+  hi = _mm_add_pd(hi, _mm_setzero_pd());
+  double l[2], h[2];
+  _mm_storeu_pd(l, lo);
+  _mm_storeu_pd(h, hi);
+  return Extent{l[0], l[1], h[0], h[1]};
+}
+
+AVX2 void segmentsAvx2(const Segments& s, double px, double py, double* out) {
+  const __m256d zero = _mm256_setzero_pd(), one = _mm256_set1_pd(1.0);
+  const __m256d vx = _mm256_set1_pd(px), vy = _mm256_set1_pd(py);
+  size_t i = 0;
+  for (; i + 4 <= s.n; i += 4) {
+    __m256d ax = _mm256_loadu_pd(s.ax + i), ay = _mm256_loadu_pd(s.ay + i);
+    __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(s.bx + i), ax);
+    __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(s.by + i), ay);
+    __m256d lenSq =
+        _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+    __m256d num = _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(vx, ax), dx),
+                                _mm256_mul_pd(_mm256_sub_pd(vy, ay), dy));
+    __m256d t =
+        _mm256_and_pd(_mm256_div_pd(num, lenSq), lt(zero, lenSq));
+    t = select(lt(t, zero), zero, select(lt(one, t), one, t));
+    __m256d ex = _mm256_sub_pd(vx, _mm256_add_pd(ax, _mm256_mul_pd(t, dx)));
+    __m256d ey = _mm256_sub_pd(vy, _mm256_add_pd(ay, _mm256_mul_pd(t, dy)));
+    _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_mul_pd(ex, ex),
+                                            _mm256_mul_pd(ey, ey)));
+  }
+  for (; i < s.n; i++)
+    out[i] = segmentDistSq(s.ax[i], s.ay[i], s.bx[i], s.by[i], px, py);
+}
+
+AVX2 void ellipsesAvx2(const Ellipses& e, double x, double y, uint8_t* hits) {
+  const __m256d zero = _mm256_setzero_pd(), one = _mm256_set1_pd(1.0);
+  const __m256d vx = _mm256_set1_pd(x), vy = _mm256_set1_pd(y);
+  size_t i = 0;
+  for (; i + 4 <= e.n; i += 4) {
+    __m256d rx = _mm256_loadu_pd(e.rx + i), ry = _mm256_loadu_pd(e.ry + i);
+    __m256d dx =
+        _mm256_div_pd(_mm256_sub_pd(vx, _mm256_loadu_pd(e.cx + i)), rx);
+    __m256d dy =
+        _mm256_div_pd(_mm256_sub_pd(vy, _mm256_loadu_pd(e.cy + i)), ry);
+    __m256d sum = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+    __m256d valid = _mm256_and_pd(lt(zero, rx), lt(zero, ry));
+    storeHits(_mm256_and_pd(valid, le(sum, one)), hits + i);
+  }
+  for (; i < e.n; i++)
+    hits[i] = ellipseHit(e.cx[i], e.cy[i], e.rx[i], e.ry[i], x, y);
+}
+
+// one lane per hexagon, the six edges are walked in the same order as the
+// scalar test and each crossing flips the lane
+AVX2 void hexagonsAvx2(const Hexagons& h, double x, double y, uint8_t* hits) {
+  const HexUnit& u = hexUnit(h.pointyTop);
+  const __m256d vx = _mm256_set1_pd(x), vy = _mm256_set1_pd(y);
+  const __m256d fuzz = _mm256_set1_pd(1000000000000.);
+  size_t i = 0;
+  for (; i + 4 <= h.n; i += 4) {
+    __m256d cx = _mm256_loadu_pd(h.cx + i), cy = _mm256_loadu_pd(h.cy + i);
+    __m256d rx = _mm256_loadu_pd(h.rx + i), ry = _mm256_loadu_pd(h.ry + i);
+    __m256d inside = _mm256_setzero_pd();
+    for (int k = 0; k < 6; k++) {
+      int j = (k + 1) % 6;
+      __m256d x1 =
+          _mm256_add_pd(cx, _mm256_mul_pd(rx, _mm256_set1_pd(u.cos[k])));
+      __m256d y1 =
+          _mm256_add_pd(cy, _mm256_mul_pd(ry, _mm256_set1_pd(u.sin[k])));
+      __m256d x2 =
+          _mm256_add_pd(cx, _mm256_mul_pd(rx, _mm256_set1_pd(u.cos[j])));
+      __m256d y2 =
+          _mm256_add_pd(cy, _mm256_mul_pd(ry, _mm256_set1_pd(u.sin[j])));
+      __m256d flat =
+          le(_mm256_mul_pd(absPd(_mm256_sub_pd(y1, y2)), fuzz),
+             _mm256_min_pd(absPd(y2), absPd(y1)));
+      __m256d sw = lt(y2, y1);
+      __m256d ya = select(sw, y2, y1), yb = select(sw, y1, y2);
+      __m256d xa = select(sw, x2, x1), xb = select(sw, x1, x2);
+      __m256d span = _mm256_and_pd(ge(vy, ya), lt(vy, yb));
+      __m256d slope =
+          _mm256_div_pd(_mm256_sub_pd(xb, xa), _mm256_sub_pd(yb, ya));
+      __m256d xi =
+          _mm256_add_pd(xa, _mm256_mul_pd(slope, _mm256_sub_pd(vy, ya)));
+      __m256d hit = _mm256_and_pd(span, le(xi, vx));
+      inside = _mm256_xor_pd(inside, _mm256_andnot_pd(flat, hit));
+    }
+    storeHits(inside, hits + i);
+  }
+  for (; i < h.n; i++)
+    hits[i] =
+        hexagonHit(h.cx[i], h.cy[i], h.rx[i], h.ry[i], h.pointyTop, x, y);
+}
+}  // namespace
+
+const Kernels& avx2Kernels() {
+  static const Kernels k{extentAvx2, segmentsAvx2, ellipsesAvx2,
+                         hexagonsAvx2};
+  return k;
+}
+
+}  // namespace GeoKernels
+
+#endif
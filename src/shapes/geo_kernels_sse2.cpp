@@ -0,0 +1,143 @@
+// geo_kernels_sse2.cpp
+// two lane sse2 versions of the hit test and bounds kernels
+
+#include "shapes/geo_kernels_internal.h"
+
+#ifdef GEO_X86_KERNELS
+#include <immintrin.h>
+
+#define SSE2 __attribute__((target("sse2")))
+
+namespace GeoKernels {
+
+namespace {
+// a where the mask is set, b elsewhere
+SSE2 inline __m128d select(__m128d mask, __m128d a, __m128d b) {
+  return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+}
+
+SSE2 inline __m128d absPd(__m128d v) {
+  return _mm_andnot_pd(_mm_set1_pd(-0.0), v);
+}
+
+SSE2 inline void storeHits(__m128d mask, uint8_t* hits) {
+  int bits = _mm_movemask_pd(mask);
+  hits[0] = bits & 1;
+  hits[1] = (bits >> 1) & 1;
+}
+
+// min_pd(p, acc) keeps acc unless p is smaller, like std::min(acc, p), and
+// two accumulators hide the compare latency
+SSE2 Extent extentSse2(const QPointF* points, size_t n) {
+  const double* xy = reinterpret_cast<const double*>(points);
+  __m128d lo0 = _mm_loadu_pd(xy), hi0 = lo0, lo1 = lo0, hi1 = lo0;
+  size_t i = 1;
+  for (; i + 2 <= n; i += 2) {
+    __m128d a = _mm_loadu_pd(xy + 2 * i);
+    __m128d b = _mm_loadu_pd(xy + 2 * i + 2);
+    lo0 = _mm_min_pd(a, lo0);
+    hi0 = _mm_max_pd(a, hi0);
+    lo1 = _mm_min_pd(b, lo1);
+    hi1 = _mm_max_pd(b, hi1);
+  }
+  if (i < n) {
+    __m128d a = _mm_loadu_pd(xy + 2 * i);
+    lo0 = _mm_min_pd(a, lo0);
+    hi0 = _mm_max_pd(a, hi0);
+  }
+  // adding zero turns a negative zero positive like the scalar kernel
+  __m128d zero = _mm_setzero_pd();
+  __m128d lo = _mm_add_pd(_mm_min_pd(lo1, lo0), zero);
+  __m128d hi = _mm_add_pd(_mm_max_pd(hi1, hi0), zero);
+  double l[2], h[2];
+  _mm_storeu_pd(l, lo);
+  _mm_storeu_pd(h, hi);
+  return Extent{l[0], l[1], h[0], h[1]};
+}
+
+SSE2 void segmentsSse2(const Segments& s, double px, double py, double* out) {
+  const __m128d zero = _mm_setzero_pd(), one = _mm_set1_pd(1.0);
+  const __m128d vx = _mm_set1_pd(px), vy = _mm_set1_pd(py);
+  size_t i = 0;
+  for (; i + 2 <= s.n; i += 2) {
+    __m128d ax = _mm_loadu_pd(s.ax + i), ay = _mm_loadu_pd(s.ay + i);
+    __m128d dx = _mm_sub_pd(_mm_loadu_pd(s.bx + i), ax);
+    __m128d dy = _mm_sub_pd(_mm_loadu_pd(s.by + i), ay);
+    __m128d lenSq = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+    __m128d num = _mm_add_pd(_mm_mul_pd(_mm_sub_pd(vx, ax), dx),
+                             _mm_mul_pd(_mm_sub_pd(vy, ay), dy));
+    __m128d t = _mm_and_pd(_mm_div_pd(num, lenSq), _mm_cmpgt_pd(lenSq, zero));
+    t = select(_mm_cmplt_pd(t, zero), zero,
+               select(_mm_cmplt_pd(one, t), one, t));
+    __m128d ex = _mm_sub_pd(vx, _mm_add_pd(ax, _mm_mul_pd(t, dx)));
+    __m128d ey = _mm_sub_pd(vy, _mm_add_pd(ay, _mm_mul_pd(t, dy)));
+    _mm_storeu_pd(out + i, _mm_add_pd(_mm_mul_pd(ex, ex), _mm_mul_pd(ey, ey)));
+  }
+  for (; i < s.n; i++)
+    out[i] = segmentDistSq(s.ax[i], s.ay[i], s.bx[i], s.by[i], px, py);
+}
+
+SSE2 void ellipsesSse2(const Ellipses& e, double x, double y, uint8_t* hits) {
+  const __m128d zero = _mm_setzero_pd(), one = _mm_set1_pd(1.0);
+  const __m128d vx = _mm_set1_pd(x), vy = _mm_set1_pd(y);
+  size_t i = 0;
+  for (; i + 2 <= e.n; i += 2) {
+    __m128d rx = _mm_loadu_pd(e.rx + i), ry = _mm_loadu_pd(e.ry + i);
+    __m128d dx = _mm_div_pd(_mm_sub_pd(vx, _mm_loadu_pd(e.cx + i)), rx);
+    __m128d dy = _mm_div_pd(_mm_sub_pd(vy, _mm_loadu_pd(e.cy + i)), ry);
+    __m128d sum = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+    __m128d valid =
+        _mm_and_pd(_mm_cmpgt_pd(rx, zero), _mm_cmpgt_pd(ry, zero));
+    storeHits(_mm_and_pd(valid, _mm_cmple_pd(sum, one)), hits + i);
+  }
+  for (; i < e.n; i++)
+    hits[i] = ellipseHit(e.cx[i], e.cy[i], e.rx[i], e.ry[i], x, y);
+}
+
+// one lane per hexagon, the six edges are walked in the same order as the
+// scalar test and each crossing flips the lane
+SSE2 void hexagonsSse2(const Hexagons& h, double x, double y, uint8_t* hits) {
+  const HexUnit& u = hexUnit(h.pointyTop);
+  const __m128d vx = _mm_set1_pd(x), vy = _mm_set1_pd(y);
+  const __m128d fuzz = _mm_set1_pd(1000000000000.);
+  size_t i = 0;
+  for (; i + 2 <= h.n; i += 2) {
+    __m128d cx = _mm_loadu_pd(h.cx + i), cy = _mm_loadu_pd(h.cy + i);
+    __m128d rx = _mm_loadu_pd(h.rx + i), ry = _mm_loadu_pd(h.ry + i);
+    __m128d inside = _mm_setzero_pd();
+    for (int k = 0; k < 6; k++) {
+      int j = (k + 1) % 6;
+      __m128d x1 = _mm_add_pd(cx, _mm_mul_pd(rx, _mm_set1_pd(u.cos[k])));
+      __m128d y1 = _mm_add_pd(cy, _mm_mul_pd(ry, _mm_set1_pd(u.sin[k])));
+      __m128d x2 = _mm_add_pd(cx, _mm_mul_pd(rx, _mm_set1_pd(u.cos[j])));
+      __m128d y2 = _mm_add_pd(cy, _mm_mul_pd(ry, _mm_set1_pd(u.sin[j])));
+      __m128d flat =
+          _mm_cmple_pd(_mm_mul_pd(absPd(_mm_sub_pd(y1, y2)), fuzz),
+                       _mm_min_pd(absPd(y2), absPd(y1)));
+      __m128d sw = _mm_cmplt_pd(y2, y1);
+      __m128d ya = select(sw, y2, y1), yb = select(sw, y1, y2);
+      __m128d xa = select(sw, x2, x1), xb = select(sw, x1, x2);
+      __m128d span = _mm_and_pd(_mm_cmpge_pd(vy, ya), _mm_cmplt_pd(vy, yb));
+      __m128d xi = _mm_add_pd(
+          xa, _mm_mul_pd(_mm_div_pd(_mm_sub_pd(xb, xa), _mm_sub_pd(yb, ya)),
+                         _mm_sub_pd(vy, ya)));
+      __m128d hit = _mm_and_pd(span, _mm_cmple_pd(xi, vx));
+      inside = _mm_xor_pd(inside, _mm_andnot_pd(flat, hit));
+    }
+    storeHits(inside, hits + i);
+  }
+  for (; i < h.n; i++)
+    hits[i] =
+        hexagonHit(h.cx[i], h.cy[i], h.rx[i], h.ry[i], h.pointyTop, x, y);
+}
+}  // namespace
+
+const Kernels& sse2Kernels() {
+  static const Kernels k{extentSse2, segmentsSse2, ellipsesSse2,
+                         hexagonsSse2};
+  return k;
+}
+
+}  // namespace GeoKernels
+
+#endif
@@ -3,27 +3,32 @@
 
 #include "shapes/hexagon.h"
 
-#include <cmath>
+#include <algorithm>
+#include <iterator>
 #include <string>
 
-static constexpr double PI = 3.14159265358979323846;
+#include "shapes/binary_format.h"
+#include "shapes/geo_kernels.h"
+#include "shapes/shape_pool.h"
+#include "shapes/svg_writer.h"
 
 // constructor stores center and radii values
 Hexagon::Hexagon(double cx, double cy, double rx, double ry)
     : cx(cx), cy(cy), rx(rx), ry(ry) {
   width = 2 * rx;
   height = 2 * ry;
+  strokePen.setJoinStyle(Qt::MiterJoin);
+  strokePen.setMiterLimit(10.0);
 }
 
 // compute polygon points with optional pointy top angular offset
 QPolygonF Hexagon::hexPoints() const {
+  // unit corners shared with the hit test kernels, 30 degrees further round
+  // for pointy top
+  const GeoKernels::HexUnit& u = GeoKernels::hexUnit(pointyTop);
   QPolygonF poly;
-  double offset =
-      pointyTop ? (PI / 6.0) : 0.0;  // 30 degree offset for pointy top
-  for (int i = 0; i < 6; i++) {
-    double angle = PI / 180.0 * (60.0 * i) + offset;
-    poly << QPointF(cx + rx * std::cos(angle), cy + ry * std::sin(angle));
-  }
+  for (int i = 0; i < 6; i++)
+    poly << QPointF(cx + rx * u.cos[i], cy + ry * u.sin[i]);
   return poly;
 }
 
@@ -33,46 +38,45 @@ void Hexagon::setPointyTop(bool pt) { pointyTop = pt; }
 
 // draw hexagon fill and stroke
 void Hexagon::draw(QPainter& painter) const {
-  QPen pen(QColor(strokeColor.c_str()));
-  pen.setWidthF(strokeWidth);
-  pen.setJoinStyle(Qt::MiterJoin);
-  pen.setMiterLimit(10.0);
-  painter.setPen(pen);
-  if (fillColor == "none") {
-    painter.setBrush(Qt::NoBrush);
-  } else {
-    painter.setBrush(QBrush(QColor(fillColor.c_str())));
-  }
+  painter.setPen(strokePen);
+  painter.setBrush(fillBrush);
   painter.drawPolygon(hexPoints());
 }
 
 // serialize shape as svg polygon with custom hexagon metadata
-std::string Hexagon::toSVG() const {
+void Hexagon::writeSVG(SvgWriter& out) const {
+  out.raw("<polygon data-shape=\"hexagon\"")
+      .attr("data-cx", cx)
+      .attr("data-cy", cy)
+      .attr("data-rx", rx)
+      .attr("data-ry", ry)
+      .attr("data-orientation", pointyTop ? "pointy" : "flat")
+      .raw(" points=\"");
+
   // svg polygon points x1, y1 and x2, y2
   QPolygonF pts = hexPoints();
-  std::string pointsStr;
   for (int i = 0; i < pts.size(); i++) {
-    if (i > 0) pointsStr += " ";
-    pointsStr += std::to_string(pts[i].x()) + "," + std::to_string(pts[i].y());
+    if (i > 0) out.raw(" ");
+    out.point(pts[i].x(), pts[i].y());
   }
-  return "<polygon data-shape=\"hexagon\" "
-         "data-cx=\"" +
-         std::to_string(cx) +
-         "\" "
-         "data-cy=\"" +
-         std::to_string(cy) +
-         "\" "
-         "data-rx=\"" +
-         std::to_string(rx) +
-         "\" "
-         "data-ry=\"" +
-         std::to_string(ry) +
-         "\" "
-         "data-orientation=\"" +
-         std::string(pointyTop ? "pointy" : "flat") +
-         "\" "
-         "points=\"" +
-         pointsStr + "\" " + svgColorAttr("stroke", strokeColor) + " " +
-         "stroke-width=\"" + std::to_string(strokeWidth) + "\" " +
-         svgColorAttr("fill", fillColor) + " />";
+  out.raw("\"");
+  writeStrokeAndFill(out);
+  out.raw(" />");
+}
+
+// fixed size record, see binary_format.h
+void Hexagon::writeBinary(BinaryFormat::Writer& out) const {
+  auto& rec = out.add(ShapeType::Hexagon, *this);
+  double geom[] = {cx, cy, rx, ry};
+  std::copy(std::begin(geom), std::end(geom), rec.geom);
+  if (pointyTop) rec.flags |= BinaryFormat::kPointyTop;
+}
+
+// shape back from its record, the reader checked the data range
+std::shared_ptr<GraphicsObject> Hexagon::fromRecord(
+    const BinaryFormat::RecordView& in) {
+  const double* g = in.rec.geom;
+  auto hex = allocateShape<Hexagon>(g[0], g[1], g[2], g[3]);
+  hex->setPointyTop(in.rec.flags & BinaryFormat::kPointyTop);
+  return hex;
 }
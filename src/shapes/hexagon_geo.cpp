@@ -3,9 +3,12 @@
 
 #include "shapes/hexagon.h"
 
-// compute hexagon points in local coordinates based on center and radii
+#include "shapes/geo_kernels.h"
+#include "shapes/shape_pool.h"
+
+// odd even test over the six corners, no polygon is built per query
 bool Hexagon::contains(double x, double y) const {
-  return hexPoints().containsPoint(QPointF(x, y), Qt::OddEvenFill);
+  return GeoKernels::hexagonHit(cx, cy, rx, ry, pointyTop, x, y);
 }
 
 // bounding box from center and radii
@@ -13,6 +16,12 @@ QRectF Hexagon::boundingBox() const {
   return QRectF(cx - rx, cy - ry, 2 * rx, 2 * ry);
 }
 
+// geometry accessors
+double Hexagon::getCx() const { return cx; }
+double Hexagon::getCy() const { return cy; }
+double Hexagon::getRx() const { return rx; }
+double Hexagon::getRy() const { return ry; }
+
 // center setter
 void Hexagon::setCenter(double x, double y) {
   cx = x;
@@ -35,11 +44,9 @@ void Hexagon::moveBy(double dx, double dy) {
 
 // clone with orientation and style
 std::shared_ptr<GraphicsObject> Hexagon::clone() const {
-  auto copy = std::make_shared<Hexagon>(cx, cy, rx, ry);
+  auto copy = allocateShape<Hexagon>(cx, cy, rx, ry);
   copy->setPointyTop(pointyTop);
-  copy->setFillColor(getFillColor());
-  copy->setStrokeColor(getStrokeColor());
-  copy->setStrokeWidth(getStrokeWidth());
+  copy->copyStyleFrom(*this);
   return copy;
 }
 
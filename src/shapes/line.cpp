@@ -5,8 +5,14 @@
 
 #include <algorithm>
 #include <cmath>
+#include <iterator>
 #include <string>
 
+#include "shapes/binary_format.h"
+#include "shapes/geo_kernels.h"
+#include "shapes/shape_pool.h"
+#include "shapes/svg_writer.h"
+
 // construct line from two endpoints and cache width and height
 Line::Line(double x1, double y1, double x2, double y2)
     : x1(x1), y1(y1), x2(x2), y2(y2) {
@@ -16,35 +22,43 @@ Line::Line(double x1, double y1, double x2, double y2)
 
 // draw line using stroke properties, no fill
 void Line::draw(QPainter& painter) const {
-  QPen pen(QColor(strokeColor.c_str()));
-  pen.setWidthF(strokeWidth);
-  painter.setPen(pen);
+  painter.setPen(strokePen);
   painter.setBrush(Qt::NoBrush);
   painter.drawLine(QPointF(x1, y1), QPointF(x2, y2));
 }
 
 // convert line to svg line tag
-std::string Line::toSVG() const {
-  return "<line x1=\"" + std::to_string(x1) + "\" y1=\"" + std::to_string(y1) +
-         "\" x2=\"" + std::to_string(x2) + "\" y2=\"" + std::to_string(y2) +
-         "\" " + svgColorAttr("stroke", strokeColor) + " stroke-width=\"" +
-         std::to_string(strokeWidth) + "\" />";
+void Line::writeSVG(SvgWriter& out) const {
+  out.raw("<line")
+      .attr("x1", x1)
+      .attr("y1", y1)
+      .attr("x2", x2)
+      .attr("y2", y2)
+      .color("stroke", strokeColor)
+      .attr("stroke-width", strokeWidth)
+      .raw(" />");
+}
+
+// fixed size record, see binary_format.h
+void Line::writeBinary(BinaryFormat::Writer& out) const {
+  auto& rec = out.add(ShapeType::Line, *this);
+  double geom[] = {x1, y1, x2, y2};
+  std::copy(std::begin(geom), std::end(geom), rec.geom);
+}
+
+// shape back from its record, the reader checked the data range
+std::shared_ptr<GraphicsObject> Line::fromRecord(
+    const BinaryFormat::RecordView& in) {
+  const double* g = in.rec.geom;
+  return allocateShape<Line>(g[0], g[1], g[2], g[3]);
 }
 
 // hit test by measuring distance to line segment
+// squared distance from the shared kernel, a zero length line measures to
+// its first endpoint
 bool Line::contains(double mx, double my) const {
-  // distance from point mx, my to the line segment x1,y1 x2,y2
-  // checks closeness to endpoints and projection onto segment for hit testing
-  double dx = x2 - x1;
-  double dy = y2 - y1;
-  double lenSq = dx * dx + dy * dy;
-  if (lenSq < 1e-6) return std::hypot(mx - x1, my - y1) < 5.0;
-
-  double t = ((mx - x1) * dx + (my - y1) * dy) / lenSq;
-  t = std::clamp(t, 0.0, 1.0);
-  double px = x1 + t * dx;
-  double py = y1 + t * dy;
-  return std::hypot(mx - px, my - py) < 5.0;
+  return GeoKernels::segmentDistSq(x1, y1, x2, y2, mx, my) <
+         kHitDistance * kHitDistance;
 }
 
 // return tight bounding box around endpoints
@@ -80,10 +94,8 @@ void Line::moveBy(double dx, double dy) {
 
 // clone line with styles for clipboard and commands
 std::shared_ptr<GraphicsObject> Line::clone() const {
-  auto copy = std::make_shared<Line>(x1, y1, x2, y2);
-  copy->setFillColor(getFillColor());
-  copy->setStrokeColor(getStrokeColor());
-  copy->setStrokeWidth(getStrokeWidth());
+  auto copy = allocateShape<Line>(x1, y1, x2, y2);
+  copy->copyStyleFrom(*this);
   return copy;
 }
 
@@ -4,12 +4,19 @@
 #include "shapes/rectangle.h"
 
 #include <algorithm>
+#include <iterator>
+
+#include "shapes/binary_format.h"
+#include "shapes/shape_pool.h"
+#include "shapes/svg_writer.h"
 
 // constructor
 Rectangle::Rectangle(double x, double y, double w, double h) : x(x), y(y) {
   // we must set these in the body because they belong to the parent class
   this->width = w;
   this->height = h;
+  strokePen.setJoinStyle(Qt::MiterJoin);
+  strokePen.setMiterLimit(10.0);
 }
 
 // bounding box
@@ -17,17 +24,8 @@ QRectF Rectangle::boundingBox() const { return QRectF(x, y, width, height); }
 
 // draw
 void Rectangle::draw(QPainter& painter) const {
-  QPen pen(QColor(strokeColor.c_str()));
-  pen.setWidthF(strokeWidth);
-  pen.setJoinStyle(Qt::MiterJoin);
-  pen.setMiterLimit(10.0);
-  painter.setPen(pen);
-
-  if (fillColor == "none") {
-    painter.setBrush(Qt::NoBrush);
-  } else {
-    painter.setBrush(QBrush(QColor(fillColor.c_str())));
-  }
+  painter.setPen(strokePen);
+  painter.setBrush(fillBrush);
 
   painter.drawRect(QRectF(x, y, width, height));
 }
@@ -38,12 +36,28 @@ bool Rectangle::contains(double mouseX, double mouseY) const {
 }
 
 // svg output
-std::string Rectangle::toSVG() const {
-  return "<rect x=\"" + std::to_string(x) + "\" " + "y=\"" + std::to_string(y) +
-         "\" " + "width=\"" + std::to_string(width) + "\" " + "height=\"" +
-         std::to_string(height) + "\" " + svgColorAttr("stroke", strokeColor) +
-         " " + "stroke-width=\"" + std::to_string(strokeWidth) + "\" " +
-         svgColorAttr("fill", fillColor) + " />";
+void Rectangle::writeSVG(SvgWriter& out) const {
+  out.raw("<rect")
+      .attr("x", x)
+      .attr("y", y)
+      .attr("width", width)
+      .attr("height", height);
+  writeStrokeAndFill(out);
+  out.raw(" />");
+}
+
+// fixed size record, see binary_format.h
+void Rectangle::writeBinary(BinaryFormat::Writer& out) const {
+  auto& rec = out.add(ShapeType::Rectangle, *this);
+  double geom[] = {x, y, width, height};
+  std::copy(std::begin(geom), std::end(geom), rec.geom);
+}
+
+// shape back from its record, the reader checked the data range
+std::shared_ptr<GraphicsObject> Rectangle::fromRecord(
+    const BinaryFormat::RecordView& in) {
+  const double* g = in.rec.geom;
+  return allocateShape<Rectangle>(g[0], g[1], g[2], g[3]);
 }
 
 // resize update the parent fields
@@ -60,10 +74,8 @@ void Rectangle::moveBy(double dx, double dy) {
 
 // clone returns an independent deep copy
 std::shared_ptr<GraphicsObject> Rectangle::clone() const {
-  auto copy = std::make_shared<Rectangle>(x, y, width, height);
-  copy->setFillColor(getFillColor());
-  copy->setStrokeColor(getStrokeColor());
-  copy->setStrokeWidth(getStrokeWidth());
+  auto copy = allocateShape<Rectangle>(x, y, width, height);
+  copy->copyStyleFrom(*this);
   return copy;
 }
 
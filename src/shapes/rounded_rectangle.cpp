@@ -5,6 +5,11 @@
 
 #include <algorithm>
 #include <cmath>
+#include <iterator>
+
+#include "shapes/binary_format.h"
+#include "shapes/shape_pool.h"
+#include "shapes/svg_writer.h"
 
 // constructor stores position size and corner radii
 RoundedRectangle::RoundedRectangle(double x, double y, double w, double h,
@@ -21,15 +26,8 @@ QRectF RoundedRectangle::boundingBox() const {
 
 // draw rounded rectangle with fill and stroke
 void RoundedRectangle::draw(QPainter& painter) const {
-  QPen pen(QColor(strokeColor.c_str()));
-  pen.setWidthF(strokeWidth);
-  painter.setPen(pen);
-
-  if (fillColor == "none") {
-    painter.setBrush(Qt::NoBrush);
-  } else {
-    painter.setBrush(QBrush(QColor(fillColor.c_str())));
-  }
+  painter.setPen(strokePen);
+  painter.setBrush(fillBrush);
 
   QRectF r = boundingBox();
   painter.drawRoundedRect(r, rx, ry);
@@ -41,15 +39,31 @@ bool RoundedRectangle::contains(double mouseX, double mouseY) const {
 }
 
 // serialize shape to svg rect with rx ry attributes
-std::string RoundedRectangle::toSVG() const {
+void RoundedRectangle::writeSVG(SvgWriter& out) const {
   QRectF r = boundingBox();
-  return "<rect x=\"" + std::to_string(r.x()) + "\" y=\"" +
-         std::to_string(r.y()) + "\" width=\"" + std::to_string(r.width()) +
-         "\" height=\"" + std::to_string(r.height()) + "\" rx=\"" +
-         std::to_string(rx) + "\" ry=\"" + std::to_string(ry) + "\" " +
-         svgColorAttr("stroke", strokeColor) + " stroke-width=\"" +
-         std::to_string(strokeWidth) + "\" " + svgColorAttr("fill", fillColor) +
-         " />";
+  out.raw("<rect")
+      .attr("x", r.x())
+      .attr("y", r.y())
+      .attr("width", r.width())
+      .attr("height", r.height())
+      .attr("rx", rx)
+      .attr("ry", ry);
+  writeStrokeAndFill(out);
+  out.raw(" />");
+}
+
+// fixed size record, see binary_format.h
+void RoundedRectangle::writeBinary(BinaryFormat::Writer& out) const {
+  auto& rec = out.add(ShapeType::RoundedRectangle, *this);
+  double geom[] = {x, y, width, height, rx, ry};
+  std::copy(std::begin(geom), std::end(geom), rec.geom);
+}
+
+// shape back from its record, the reader checked the data range
+std::shared_ptr<GraphicsObject> RoundedRectangle::fromRecord(
+    const BinaryFormat::RecordView& in) {
+  const double* g = in.rec.geom;
+  return allocateShape<RoundedRectangle>(g[0], g[1], g[2], g[3], g[4], g[5]);
 }
 
 // update width and height from drag values
@@ -75,10 +89,8 @@ void RoundedRectangle::moveBy(double dx, double dy) {
 
 // deep copy with style and geometry
 std::shared_ptr<GraphicsObject> RoundedRectangle::clone() const {
-  auto copy = std::make_shared<RoundedRectangle>(x, y, width, height, rx, ry);
-  copy->setFillColor(getFillColor());
-  copy->setStrokeColor(getStrokeColor());
-  copy->setStrokeWidth(getStrokeWidth());
+  auto copy = allocateShape<RoundedRectangle>(x, y, width, height, rx, ry);
+  copy->copyStyleFrom(*this);
   return copy;
 }
 
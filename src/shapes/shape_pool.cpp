@@ -0,0 +1,80 @@
+// shape_pool.cpp
+// per document pools behind shape allocation
+
+#include "shapes/shape_pool.h"
+
+#include <atomic>
+
+namespace {
+// blocks above this go straight to the heap, long strokes are rare and big
+const size_t kLargestPooledBlock = 4096;
+
+// size class pool that counts its live blocks, so it knows when handing
+// everything back cannot pull memory from under a shape
+// the pool keeps per thread free lists, parse workers do not contend
+class ShapePool : public std::pmr::memory_resource {
+ public:
+  bool unused() const { return live.load(std::memory_order_acquire) == 0; }
+
+  // only at a quiet point, no thread may be allocating from this pool
+  bool releaseIfUnused() {
+    if (!unused()) return false;
+    pool.release();
+    return true;
+  }
+
+ private:
+  std::pmr::synchronized_pool_resource pool{
+      std::pmr::pool_options{0, kLargestPooledBlock}};
+  std::atomic<size_t> live{0};
+
+  void* do_allocate(size_t bytes, size_t align) override {
+    void* p = pool.allocate(bytes, align);
+    live.fetch_add(1, std::memory_order_relaxed);
+    return p;
+  }
+  void do_deallocate(void* p, size_t bytes, size_t align) override {
+    pool.deallocate(p, bytes, align);
+    live.fetch_sub(1, std::memory_order_release);
+  }
+  bool do_is_equal(const memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+// every pool ever started, never destroyed, shapes held by statics such as
+// the clipboard may be released after main returns
+// only touched on the gui thread
+std::vector<ShapePool*>& pools() {
+  static auto* all = new std::vector<ShapePool*>{new ShapePool};
+  return *all;
+}
+
+std::atomic<ShapePool*>& current() {
+  static std::atomic<ShapePool*> pool{pools().front()};
+  return pool;
+}
+}  // namespace
+
+std::pmr::memory_resource* shapeMemory() {
+  return current().load(std::memory_order_acquire);
+}
+
+// an idle pool from an earlier document is reused before making a new one
+void beginShapeGeneration() {
+  ShapePool* next = nullptr;
+  for (ShapePool* p : pools()) {
+    if (p != current().load() && p->unused()) next = p;
+  }
+  if (!next) {
+    next = new ShapePool;
+    pools().push_back(next);
+  }
+  current().store(next, std::memory_order_release);
+}
+
+bool releaseShapeMemory() {
+  bool all = true;
+  for (ShapePool* p : pools()) all = p->releaseIfUnused() && all;
+  return all;
+}
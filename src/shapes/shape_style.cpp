@@ -0,0 +1,67 @@
+// shape_style.cpp
+// conversions between packed shape colours and colour strings
+
+#include "shapes/shape_style.h"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+// unknown colour names by id, names are never dropped, a document only
+// has a handful and a shape may refer to one long after its file closed
+// locked, the parser reads colours on worker threads
+class NameTable {
+ public:
+  QRgb intern(const std::string& text) {
+    std::lock_guard<std::mutex> hold(lock);
+    auto it = ids.find(text);
+    if (it != ids.end()) return it->second;
+    names.push_back(text);
+    QRgb id = static_cast<QRgb>(names.size() - 1);
+    ids.emplace(names.back(), id);
+    return id;
+  }
+  // deque elements never move, the text stays valid after the lock
+  std::string_view text(QRgb id) {
+    std::lock_guard<std::mutex> hold(lock);
+    return id < names.size() ? std::string_view(names[id]) : "";
+  }
+
+ private:
+  std::mutex lock;
+  std::deque<std::string> names;
+  std::unordered_map<std::string_view, QRgb> ids;
+};
+
+NameTable& nameTable() {
+  static auto* table = new NameTable;
+  return *table;
+}
+}  // namespace
+
+ShapeColor ShapeColor::fromString(const std::string& color) {
+  if (color.empty() || color == "none" || color == "transparent") return {};
+  QColor parsed(QString::fromStdString(color));
+  if (parsed.isValid()) return fromQColor(parsed);
+  return {nameTable().intern(color), true, true};
+}
+
+ShapeColor ShapeColor::fromQColor(const QColor& color) {
+  if (!color.isValid()) return {};
+  return {color.rgba(), false};
+}
+
+std::string_view ShapeColor::name() const {
+  return named ? nameTable().text(argb) : std::string_view();
+}
+
+std::string ShapeColor::toString() const {
+  if (named) return std::string(name());
+  if (none) return "transparent";
+  return QColor::fromRgba(argb).name(QColor::HexArgb).toStdString();
+}
+
+QColor ShapeColor::toQColor() const {
+  return none ? QColor(Qt::transparent) : QColor::fromRgba(argb);
+}
@@ -0,0 +1,16 @@
+// shape_type.cpp
+// names of the shape type tags
+
+#include "shapes/shape_type.h"
+
+const char* shapeTypeName(ShapeType type) {
+  switch (type) {
+#define SHAPE_TYPE_NAME(tag, cls, name) \
+  case ShapeType::tag:                  \
+    return name;
+    SHAPE_TYPES(SHAPE_TYPE_NAME)
+#undef SHAPE_TYPE_NAME
+    default:
+      return "";
+  }
+}
@@ -0,0 +1,73 @@
+// svg_document.cpp
+// svg document serialization split across worker threads
+
+#include "shapes/svg_document.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace {
+// below this many shapes per worker thread start up costs more than it saves
+const size_t kMinRangeShapes = 4096;
+// more ranges than workers so ranges of heavy shapes still balance out
+const size_t kRangesPerWorker = 4;
+}  // namespace
+
+void writeSvgShape(SvgWriter& out, const GraphicsObject& shape) {
+  out.raw("  ");
+  shape.writeSVG(out);
+  out.raw("\n");
+}
+
+void writeSvgDocument(
+    SvgWriter& out, int width, int height,
+    const std::vector<std::shared_ptr<GraphicsObject>>& shapes) {
+  writeSvgDocument(out, width, height, shapes.size(),
+                   [&](SvgWriter& part, size_t first, size_t last) {
+                     for (size_t i = first; i < last; i++)
+                       writeSvgShape(part, *shapes[i]);
+                   });
+}
+
+void writeSvgDocument(SvgWriter& out, int width, int height, size_t count,
+                      const SvgRangeWriter& writeRange) {
+  out.raw("<svg")
+      .attr("width", width)
+      .attr("height", height)
+      .raw(" xmlns=\"http://www.w3.org/2000/svg\">\n");
+
+  size_t workers = std::max(1u, std::thread::hardware_concurrency());
+  workers = std::min(workers, count / kMinRangeShapes + 1);
+  if (workers == 1) {
+    writeRange(out, 0, count);
+    out.raw("</svg>\n");
+    return;
+  }
+
+  // each range gets its own buffer, joined in document order afterwards
+  size_t ranges = workers * kRangesPerWorker;
+  size_t step = (count + ranges - 1) / ranges;
+  std::vector<SvgWriter> parts(ranges);
+  std::atomic<size_t> next{0};
+  auto work = [&]() {
+    size_t i = next.fetch_add(1);
+    while (i < ranges) {
+      size_t first = std::min(count, i * step);
+      size_t last = std::min(count, first + step);
+      writeRange(parts[i], first, last);
+      i = next.fetch_add(1);
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (size_t t = 1; t < workers; t++) pool.emplace_back(work);
+  work();
+  for (auto& th : pool) th.join();
+
+  size_t total = out.data().size();
+  for (const auto& part : parts) total += part.data().size();
+  out.reserve(total + 8);
+  for (const auto& part : parts) out.raw(part.data());
+  out.raw("</svg>\n");
+}
@@ -0,0 +1,127 @@
+// svg_writer.cpp
+// number, colour and escaping helpers of the svg output buffer
+
+#include "shapes/svg_writer.h"
+
+#include <charconv>
+
+namespace {
+const char kHex[] = "0123456789abcdef";
+
+void appendHexByte(std::string& out, int v) {
+  out += kHex[(v >> 4) & 0xF];
+  out += kHex[v & 0xF];
+}
+}  // namespace
+
+void SvgWriter::clear() { buf.clear(); }
+void SvgWriter::reserve(size_t bytes) { buf.reserve(bytes); }
+const std::string& SvgWriter::data() const { return buf; }
+
+SvgWriter& SvgWriter::raw(std::string_view text) {
+  buf.append(text);
+  return *this;
+}
+
+SvgWriter& SvgWriter::escaped(std::string_view text) {
+  size_t pos = 0;
+  while (pos < text.size()) {
+    size_t special = text.find_first_of("&<>\"'", pos);
+    if (special == std::string_view::npos) special = text.size();
+    buf.append(text.substr(pos, special - pos));
+    if (special == text.size()) break;
+    switch (text[special]) {
+      case '&':
+        buf += "&amp;";
+        break;
+      case '<':
+        buf += "&lt;";
+        break;
+      case '>':
+        buf += "&gt;";
+        break;
+      case '"':
+        buf += "&quot;";
+        break;
+      default:
+        buf += "&apos;";
+        break;
+    }
+    pos = special + 1;
+  }
+  return *this;
+}
+
+SvgWriter& SvgWriter::number(double value) {
+  char tmp[32];
+  auto res = std::to_chars(tmp, tmp + sizeof(tmp), value);
+  buf.append(tmp, res.ptr - tmp);
+  return *this;
+}
+
+SvgWriter& SvgWriter::point(double x, double y) {
+  number(x);
+  buf += ',';
+  return number(y);
+}
+
+SvgWriter& SvgWriter::attr(std::string_view name, double value) {
+  buf += ' ';
+  buf.append(name);
+  buf += "=\"";
+  number(value);
+  buf += '"';
+  return *this;
+}
+
+SvgWriter& SvgWriter::attr(std::string_view name, std::string_view value) {
+  buf += ' ';
+  buf.append(name);
+  buf += "=\"";
+  escaped(value);
+  buf += '"';
+  return *this;
+}
+
+// opacity keeps the fixed three decimals earlier files were written with
+SvgWriter& SvgWriter::color(std::string_view name, const ShapeColor& c) {
+  buf += ' ';
+  buf.append(name);
+  if (c.named) {
+    buf += "=\"";
+    escaped(c.name());
+    buf += '"';
+    return *this;
+  }
+  if (c.none) {
+    buf += "=\"none\"";
+    return *this;
+  }
+  buf += "=\"#";
+  appendHexByte(buf, qRed(c.argb));
+  appendHexByte(buf, qGreen(c.argb));
+  appendHexByte(buf, qBlue(c.argb));
+  buf += '"';
+  if (qAlpha(c.argb) < 255) {
+    char tmp[16];
+    auto res = std::to_chars(tmp, tmp + sizeof(tmp), qAlpha(c.argb) / 255.0,
+                             std::chars_format::fixed, 3);
+    buf += ' ';
+    buf.append(name);
+    buf += "-opacity=\"";
+    buf.append(tmp, res.ptr - tmp);
+    buf += '"';
+  }
+  return *this;
+}
+
+SvgWriter& SvgWriter::colorString(const ShapeColor& c) {
+  if (c.named) return escaped(c.name());
+  if (c.none) return raw("transparent");
+  buf += '#';
+  appendHexByte(buf, qAlpha(c.argb));
+  appendHexByte(buf, qRed(c.argb));
+  appendHexByte(buf, qGreen(c.argb));
+  appendHexByte(buf, qBlue(c.argb));
+  return *this;
+}
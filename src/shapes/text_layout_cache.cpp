@@ -0,0 +1,41 @@
+// text_layout_cache.cpp
+// shared font cache for text shapes, bounded by least recent use
+
+#include "shapes/text_layout_cache.h"
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace {
+// documents rarely use more than a handful of family and size pairs, a
+// size slider sweep should not keep every step alive
+const size_t kMaxFonts = 64;
+}  // namespace
+
+// the lock only matters for shapes built off the gui thread by the parser
+std::shared_ptr<const TextFont> textFont(const std::string& family, int size) {
+  using Key = std::pair<std::string, int>;
+  using Entry = std::pair<Key, std::shared_ptr<const TextFont>>;
+  static std::mutex lock;
+  static std::list<Entry> recent;  // most recently used first
+  static std::map<Key, std::list<Entry>::iterator> cache;
+
+  std::lock_guard<std::mutex> guard(lock);
+  Key key{family, size};
+  auto it = cache.find(key);
+  if (it != cache.end()) {
+    recent.splice(recent.begin(), recent, it->second);
+    return it->second->second;
+  }
+  auto font = std::make_shared<const TextFont>(
+      QFont(QString::fromStdString(family), size));
+  recent.emplace_front(key, font);
+  cache[key] = recent.begin();
+  if (recent.size() > kMaxFonts) {
+    cache.erase(recent.back().first);
+    recent.pop_back();
+  }
+  return font;
+}
@@ -3,61 +3,49 @@
 
 #include "shapes/text_shape.h"
 
-#include <QFont>
-#include <QFontMetricsF>
 #include <QPainterPath>
 
+#include "shapes/binary_format.h"
+#include "shapes/shape_pool.h"
+#include "shapes/svg_writer.h"
+
 // constructor sets initial text highlight and stroke defaults
 TextShape::TextShape(double x, double y, const std::string& text)
     : x(x), y(y), text(text) {
-  fillColor = "#280078d4";
-  strokeColor = "#ff000000";
-  strokeWidth = 1.0;
+  setFillColor(ShapeColor{qRgba(0, 120, 212, 40), false});
+  setStrokeColor(ShapeColor{qRgba(0, 0, 0, 255), false});
+  setStrokeWidth(1.0);
 }
 
 // render text using QPainter, convert to SVG <text> element, and hit test
 void TextShape::draw(QPainter& painter) const {
-  QFont f(QString::fromStdString(fontFamily), fontSize);
-  painter.setFont(f);
+  ensureLayout();
 
   // draw highlight rectangle behind text if fill color is not none or
   // transparent
-  QColor bg(fillColor.c_str());
-  if (bg.isValid() && fillColor != "transparent" && fillColor != "none") {
+  if (!fillColor.none) {
     painter.setPen(Qt::NoPen);
-    painter.setBrush(bg);
-    painter.drawRect(boundingBox());
-  }
-
-  QColor c(strokeColor.c_str());
-  if (!c.isValid() || strokeColor == "transparent" || strokeColor == "none") {
-    c = Qt::black;
+    painter.setBrush(fillBrush);
+    painter.drawRect(layoutBox);
   }
-  QString qText = QString::fromStdString(text);
-  QPainterPath path;
-  path.addText(QPointF(x, y), f, qText);
 
+  QColor c = strokeColor.none ? QColor(Qt::black) : strokeColor.toQColor();
   painter.setPen(Qt::NoPen);
   painter.setBrush(c);
-  painter.drawPath(path);
+  painter.drawPath(glyphPath);
 
   if (strokeWidth > 1.0) {
     QPen p(c);
     p.setWidthF(strokeWidth - 1.0);
     p.setJoinStyle(Qt::RoundJoin);
-    painter.strokePath(path, p);
+    painter.strokePath(glyphPath, p);
   }
 }
 
-// compute bounding box based on font metrics and text content
+// bounding box from the cached font metrics and text content
 QRectF TextShape::boundingBox() const {
-  QFont f(QString::fromStdString(fontFamily), fontSize);
-  QFontMetricsF fm(f);
-
-  QString t = QString::fromStdString(text.empty() ? " " : text);
-  double w = fm.horizontalAdvance(t);
-  double h = fm.height();
-  return QRectF(x, y - fm.ascent(), w, h);
+  ensureLayout();
+  return layoutBox;
 }
 
 // hit test based on bounding box
@@ -65,41 +53,43 @@ bool TextShape::contains(double px, double py) const {
   return boundingBox().contains(px, py);
 }
 
-// escape xml special characters for valid svg output
-std::string TextShape::escapeXml(const std::string& s) {
-  std::string out;
-  out.reserve(s.size());
-  for (char ch : s) {
-    switch (ch) {
-      case '&':
-        out += "&amp;";
-        break;
-      case '<':
-        out += "&lt;";
-        break;
-      case '>':
-        out += "&gt;";
-        break;
-      case '"':
-        out += "&quot;";
-        break;
-      case '\'':
-        out += "&apos;";
-        break;
-      default:
-        out += ch;
-        break;
-    }
-  }
-  return out;
+// serialize text with font properties and highlight metadata
+void TextShape::writeSVG(SvgWriter& out) const {
+  out.raw("<text data-shape=\"text\"")
+      .attr("x", x)
+      .attr("y", y)
+      .attr("font-family", fontFamily)
+      .attr("font-size", fontSize)
+      .raw(" data-highlight-fill=\"")
+      .colorString(fillColor)
+      .raw("\"")
+      .color("fill", strokeColor)
+      .attr("stroke-width", strokeWidth)
+      .raw(">")
+      .escaped(text)
+      .raw("</text>");
 }
 
-// serialize text with font properties and highlight metadata
-std::string TextShape::toSVG() const {
-  return "<text data-shape=\"text\" x=\"" + std::to_string(x) + "\" y=\"" +
-         std::to_string(y) + "\" font-family=\"" + escapeXml(fontFamily) +
-         "\" font-size=\"" + std::to_string(fontSize) +
-         "\" data-highlight-fill=\"" + escapeXml(fillColor) + "\" " +
-         svgColorAttr("fill", strokeColor) + " stroke-width=\"" +
-         std::to_string(strokeWidth) + "\">" + escapeXml(text) + "</text>";
+// fixed size record, see binary_format.h
+void TextShape::writeBinary(BinaryFormat::Writer& out) const {
+  auto& rec = out.add(ShapeType::Text, *this);
+  rec.geom[0] = x;
+  rec.geom[1] = y;
+  rec.fontSize = fontSize;
+  rec.dataOffset = out.addString(text);
+  rec.dataCount = text.size();
+  out.addString(fontFamily);
+  rec.dataCount2 = fontFamily.size();
+}
+
+// shape back from its record, the reader checked the data range
+std::shared_ptr<GraphicsObject> TextShape::fromRecord(
+    const BinaryFormat::RecordView& in) {
+  const auto& r = in.rec;
+  const char* text = in.strings + r.dataOffset;
+  auto t = allocateShape<TextShape>(r.geom[0], r.geom[1],
+                                    std::string(text, r.dataCount));
+  t->setFontFamily(std::string(text + r.dataCount, r.dataCount2));
+  t->setFontSize(r.fontSize);
+  return t;
 }
@@ -1,43 +1,63 @@
 // text_shape_ops.cpp
-// text shape operations for move, clone and resize by bounding box
-
-#include <QFont>
-#include <QFontMetricsF>
+// text shape operations for move, clone, layout and resize by bounding box
 
+#include "shapes/shape_pool.h"
+#include "shapes/text_layout_cache.h"
 #include "shapes/text_shape.h"
 
-// translate text position by offset
+// translate text position by offset, a built layout moves along with it
 void TextShape::moveBy(double dx, double dy) {
   x += dx;
   y += dy;
+  if (layoutValid) {
+    glyphPath.translate(dx, dy);
+    layoutBox.translate(dx, dy);
+  }
 }
 
 // deep copy text shape with geometry, text and font for clipboard and commands
 std::shared_ptr<GraphicsObject> TextShape::clone() const {
-  auto copy = std::make_shared<TextShape>(x, y, text);
+  auto copy = allocateShape<TextShape>(x, y, text);
   copy->fontFamily = fontFamily;
   copy->fontSize = fontSize;
-  copy->setFillColor(getFillColor());
-  copy->setStrokeColor(getStrokeColor());
-  copy->setStrokeWidth(getStrokeWidth());
+  copy->copyStyleFrom(*this);
   return copy;
 }
 
 // align text anchor to top left of bounding box while keeping baseline offset
 void TextShape::setFromBoundingBox(const QRectF& box) {
-  QFont f(QString::fromStdString(fontFamily), fontSize);
-  QFontMetricsF fm(f);
   x = box.x();
-  y = box.y() + fm.ascent();
+  y = box.y() + textFont(fontFamily, fontSize)->metrics.ascent();
+  invalidateLayout();
+}
+
+// build glyph path and bounds once, reused until text, font or anchor change
+void TextShape::ensureLayout() const {
+  if (layoutValid) return;
+  auto tf = textFont(fontFamily, fontSize);
+  QString t = QString::fromStdString(text);
+
+  // empty text still gets a box one space wide so it can be clicked
+  double w = tf->metrics.horizontalAdvance(text.empty() ? QString(" ") : t);
+  layoutBox = QRectF(x, y - tf->metrics.ascent(), w, tf->metrics.height());
+  glyphPath = QPainterPath();
+  glyphPath.addText(QPointF(x, y), tf->font, t);
+  layoutValid = true;
 }
 
+void TextShape::invalidateLayout() { layoutValid = false; }
+
 // text content getters and setters
-void TextShape::setText(const std::string& value) { text = value; }
+void TextShape::setText(const std::string& value) {
+  text = value;
+  invalidateLayout();
+}
 const std::string& TextShape::getText() const { return text; }
 
 // font family getters and setters
 void TextShape::setFontFamily(const std::string& family) {
   fontFamily = family;
+  invalidateLayout();
 }
 const std::string& TextShape::getFontFamily() const { return fontFamily; }
 
@@ -46,6 +66,7 @@ void TextShape::setFontSize(int size) {
   if (size < 6) size = 6;
   if (size > 200) size = 200;
   fontSize = size;
+  invalidateLayout();
 }
 
 int TextShape::getFontSize() const { return fontSize; }
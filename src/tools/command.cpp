@@ -3,8 +3,6 @@
 
 #include "tools/command.h"
 
-#include <algorithm>
-
 #include "gui/canvas.h"
 #include "shapes/graphics_object.h"
 
@@ -14,38 +12,33 @@ Command::~Command() = default;
 AddShapeCommand::AddShapeCommand(std::shared_ptr<GraphicsObject> s)
     : shape(std::move(s)) {}
 
-// redo add shape by pushing it to the canvas shape list and selecting it
+// redo add shape by putting it back in the canvas and selecting it
 void AddShapeCommand::redo(Canvas* c) {
-  c->getShapes().push_back(shape);
+  c->insertShape(shape, z);
   c->setSelectedShape(shape);
-  c->update();
 }
 
 // undo add shape by removing the same shape instance
 void AddShapeCommand::undo(Canvas* c) {
-  auto& shapes = c->getShapes();
-  shapes.erase(std::remove(shapes.begin(), shapes.end(), shape), shapes.end());
+  z = c->removeShape(shape);
   if (c->getSelectedShape() == shape) c->setSelectedShape(nullptr);
-  c->update();
 }
 
 // removeshapecommand
-RemoveShapeCommand::RemoveShapeCommand(std::shared_ptr<GraphicsObject> s)
-    : shape(std::move(s)) {}
+RemoveShapeCommand::RemoveShapeCommand(std::shared_ptr<GraphicsObject> s,
+                                       ShapeStore::ZKey z)
+    : shape(std::move(s)), z(z) {}
 
-// redo remove shape by erasing it from shape list
+// redo remove shape by erasing it from the document
 void RemoveShapeCommand::redo(Canvas* c) {
-  auto& shapes = c->getShapes();
-  shapes.erase(std::remove(shapes.begin(), shapes.end(), shape), shapes.end());
+  c->removeShape(shape);
   if (c->getSelectedShape() == shape) c->setSelectedShape(nullptr);
-  c->update();
 }
 
-// undo remove shape by re adding it
+// undo remove shape by re adding it at the z key it had
 void RemoveShapeCommand::undo(Canvas* c) {
-  c->getShapes().push_back(shape);
+  c->insertShape(shape, z);
   c->setSelectedShape(shape);
-  c->update();
 }
 
 // movecommand
@@ -55,14 +48,16 @@ MoveCommand::MoveCommand(std::shared_ptr<GraphicsObject> s, double dx,
 
 // redo move by applying stored delta
 void MoveCommand::redo(Canvas* c) {
+  c->aboutToChange(shape);
   shape->moveBy(dx, dy);
-  c->update();
+  c->shapeChanged(shape);
 }
 
 // undo move by applying negative stored delta
 void MoveCommand::undo(Canvas* c) {
+  c->aboutToChange(shape);
   shape->moveBy(-dx, -dy);
-  c->update();
+  c->shapeChanged(shape);
 }
 
 // resizecommand
@@ -72,32 +67,31 @@ ResizeCommand::ResizeCommand(std::shared_ptr<GraphicsObject> s, QRectF oldBox,
 
 // redo resize by restoring new box
 void ResizeCommand::redo(Canvas* c) {
+  c->aboutToChange(shape);
   shape->setFromBoundingBox(newBox);
-  c->update();
+  c->shapeChanged(shape);
 }
 
 // undo resize by restoring original box
 void ResizeCommand::undo(Canvas* c) {
+  c->aboutToChange(shape);
   shape->setFromBoundingBox(oldBox);
-  c->update();
+  c->shapeChanged(shape);
 }
 
 // clearallcommand
-ClearAllCommand::ClearAllCommand(
-    std::vector<std::shared_ptr<GraphicsObject>> shapes,
-    std::shared_ptr<GraphicsObject> sel)
+ClearAllCommand::ClearAllCommand(ShapeStore shapes,
+                                 std::shared_ptr<GraphicsObject> sel)
     : saved(std::move(shapes)), savedSelection(std::move(sel)) {}
 
 // redo clear by emptying all shapes
 void ClearAllCommand::redo(Canvas* c) {
-  c->getShapes().clear();
+  c->setShapes({});
   c->setSelectedShape(nullptr);
-  c->update();
 }
 
-// undo clear by restoring saved list and selection
+// undo clear by restoring the saved store with its keys and the selection
 void ClearAllCommand::undo(Canvas* c) {
-  c->getShapes() = saved;
+  c->setShapes(saved);
   c->setSelectedShape(savedSelection);
-  c->update();
 }
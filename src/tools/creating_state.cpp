@@ -4,16 +4,13 @@
 #include "tools/creating_state.h"
 
 #include <cmath>
+#include <type_traits>
 
 #include "gui/canvas.h"
-#include "shapes/circle.h"
-#include "shapes/freehand.h"
-#include "shapes/hexagon.h"
-#include "shapes/line.h"
-#include "shapes/rectangle.h"
-#include "shapes/rounded_rectangle.h"
+#include "shapes/shape_visit.h"
 #include "tools/command.h"
 #include "tools/idle_state.h"
+#include "tools/shape_style_defaults.h"
 
 // press is ignored because creation starts on previous idle press
 void CreatingState::handleMousePress(Canvas*, QMouseEvent*) {
@@ -26,46 +23,35 @@ void CreatingState::handleMouseMove(Canvas* canvas, QMouseEvent* event) {
 
   auto& preview = canvas->getPreviewShape();
   if (!preview) return;
+  if (!canvas->hasStaticLayer()) canvas->beginStaticLayer(nullptr);
 
   QPointF current = event->position();
   QPointF start = canvas->getStartPoint();
 
-  // each shape mode maps drag coordinates to its own geometry update
-  if (canvas->getMode() == ShapeMode::FREEHAND) {
-    auto fh = std::dynamic_pointer_cast<Freehand>(preview);
-    if (fh) fh->addPoint(current.x(), current.y());
-
-  } else if (canvas->getMode() == ShapeMode::CIRCLE) {
-    double r = std::sqrt(std::pow(current.x() - start.x(), 2) +
-                         std::pow(current.y() - start.y(), 2));
-    auto circle = std::dynamic_pointer_cast<Circle>(preview);
-    if (circle) circle->setRadius(r);
-
-  } else if (canvas->getMode() == ShapeMode::HEXAGON) {
-    double dx = std::abs(current.x() - start.x());
-    double dy = std::abs(current.y() - start.y());
-    auto hex = std::dynamic_pointer_cast<Hexagon>(preview);
-    if (hex) hex->setRadii(dx, dy);
-
-  } else if (canvas->getMode() == ShapeMode::LINE) {
-    auto line = std::dynamic_pointer_cast<Line>(preview);
-    if (line)
-      line->setEndpoints(start.x(), start.y(), current.x(), current.y());
-
-  } else if (canvas->getMode() == ShapeMode::ROUNDED_RECT) {
-    double w = current.x() - start.x();
-    double h = current.y() - start.y();
-    auto rr = std::dynamic_pointer_cast<RoundedRectangle>(preview);
-    if (rr) rr->setGeometry(w, h);
-
-  } else {
-    double w = current.x() - start.x();
-    double h = current.y() - start.y();
-    auto rect = std::dynamic_pointer_cast<Rectangle>(preview);
-    if (rect) rect->setGeometry(w, h);
-  }
+  // each preview class maps drag coordinates to its own geometry update
+  double w = current.x() - start.x();
+  double h = current.y() - start.y();
+  visitShape(*preview, [&](auto& shape) {
+    using T = std::decay_t<decltype(shape)>;
+    if constexpr (std::is_same_v<T, Freehand>) {
+      shape.addPoint(current.x(), current.y());
+    } else if constexpr (std::is_same_v<T, Circle>) {
+      shape.setRadius(std::sqrt(w * w + h * h));
+    } else if constexpr (std::is_same_v<T, Hexagon>) {
+      shape.setRadii(std::abs(w), std::abs(h));
+    } else if constexpr (std::is_same_v<T, Line>) {
+      shape.setEndpoints(start.x(), start.y(), current.x(), current.y());
+    } else if constexpr (std::is_same_v<T, Rectangle> ||
+                         std::is_same_v<T, RoundedRectangle>) {
+      shape.setGeometry(w, h);
+    } else if constexpr (std::is_same_v<T, TextShape>) {
+      // text is placed by a click, it never has a drag preview
+    } else {
+      static_assert(alwaysFalse<T>, "creating does not handle this shape");
+    }
+  });
 
-  canvas->update();
+  canvas->previewChanged();
 }
 
 // commit preview to shape list and push add command when size is valid
@@ -77,7 +63,13 @@ void CreatingState::handleMouseRelease(Canvas* canvas, QMouseEvent* event) {
   if (preview) {
     QRectF box = preview->boundingBox();
     if (std::abs(box.width()) > 2 || std::abs(box.height()) > 2) {
-      canvas->getShapes().push_back(preview);
+      // thin out raw mouse samples before the stroke enters the document
+      auto fh = shapeCast<Freehand>(preview);
+      if (fh) {
+        size_t removed = fh->simplify(getCreationDefaults().simplifyTolerance);
+        if (removed > 0) emit canvas->strokeSimplified(removed);
+      }
+      canvas->addShape(preview);
       canvas->setSelectedShape(preview);
       canvas->pushCommand(std::make_unique<AddShapeCommand>(preview));
     }
@@ -85,5 +77,4 @@ void CreatingState::handleMouseRelease(Canvas* canvas, QMouseEvent* event) {
   }
 
   canvas->setState(std::make_unique<IdleState>());
-  canvas->update();
 }
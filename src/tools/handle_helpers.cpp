@@ -4,9 +4,9 @@
 #include "tools/handle_helpers.h"
 
 #include <cmath>
+#include <type_traits>
 
-#include "shapes/line.h"
-#include "shapes/text_shape.h"
+#include "shapes/shape_visit.h"
 
 // hit test a point against the selection handles of a shape
 HandleType getHandleAt(QPointF point,
@@ -18,34 +18,39 @@ HandleType getHandleAt(QPointF point,
            std::abs(point.y() - py) <= HANDLE_TOLERANCE;
   };
 
-  // line exposes only two endpoint handles
-  auto line = std::dynamic_pointer_cast<Line>(shape);
-  if (line) {
-    if (isNear(line->getX1(), line->getY1())) return HandleType::LINE_START;
-    if (isNear(line->getX2(), line->getY2())) return HandleType::LINE_END;
-    return HandleType::NONE;
-  }
-
-  // text is not resized by handles
-  // there are no handles for text
-  auto text = std::dynamic_pointer_cast<TextShape>(shape);
-  if (text) return HandleType::NONE;
-
-  QRectF box = shape->boundingBox();
-  double x = box.x(), y = box.y();
-  double w = box.width(), h = box.height();
-  double hw = w / 2.0, hh = h / 2.0;
-
-  if (isNear(x, y)) return HandleType::TOP_LEFT;
-  if (isNear(x + hw, y)) return HandleType::TOP;
-  if (isNear(x + w, y)) return HandleType::TOP_RIGHT;
-  if (isNear(x, y + hh)) return HandleType::LEFT;
-  if (isNear(x + w, y + hh)) return HandleType::RIGHT;
-  if (isNear(x, y + h)) return HandleType::BOTTOM_LEFT;
-  if (isNear(x + hw, y + h)) return HandleType::BOTTOM;
-  if (isNear(x + w, y + h)) return HandleType::BOTTOM_RIGHT;
+  return visitShape(*shape, [&](auto& s) {
+    using T = std::decay_t<decltype(s)>;
+    if constexpr (std::is_same_v<T, Line>) {
+      // line exposes only two endpoint handles
+      if (isNear(s.getX1(), s.getY1())) return HandleType::LINE_START;
+      if (isNear(s.getX2(), s.getY2())) return HandleType::LINE_END;
+      return HandleType::NONE;
+    } else if constexpr (std::is_same_v<T, TextShape>) {
+      // text is not resized by handles
+      return HandleType::NONE;
+    } else if constexpr (std::is_same_v<T, Rectangle> ||
+                         std::is_same_v<T, RoundedRectangle> ||
+                         std::is_same_v<T, Circle> ||
+                         std::is_same_v<T, Hexagon> ||
+                         std::is_same_v<T, Freehand>) {
+      QRectF box = s.boundingBox();
+      double x = box.x(), y = box.y();
+      double w = box.width(), h = box.height();
+      double hw = w / 2.0, hh = h / 2.0;
 
-  return HandleType::NONE;
+      if (isNear(x, y)) return HandleType::TOP_LEFT;
+      if (isNear(x + hw, y)) return HandleType::TOP;
+      if (isNear(x + w, y)) return HandleType::TOP_RIGHT;
+      if (isNear(x, y + hh)) return HandleType::LEFT;
+      if (isNear(x + w, y + hh)) return HandleType::RIGHT;
+      if (isNear(x, y + h)) return HandleType::BOTTOM_LEFT;
+      if (isNear(x + hw, y + h)) return HandleType::BOTTOM;
+      if (isNear(x + w, y + h)) return HandleType::BOTTOM_RIGHT;
+      return HandleType::NONE;
+    } else {
+      static_assert(alwaysFalse<T>, "handles do not cover this shape");
+    }
+  });
 }
 
 // set cursor icon according to hovered handle type depending on mode
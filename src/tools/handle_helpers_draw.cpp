@@ -2,54 +2,44 @@
 // helper functions for drawing selection handles and visuals for different
 // shapes
 
-#include "shapes/line.h"
-#include "shapes/text_shape.h"
-#include "tools/handle_helpers.h"
+#include <algorithm>
+#include <type_traits>
 
-// draw selection handles for a shape, with different styles for lines and text
-void drawSelectionHandles(QPainter& painter,
-                          const std::shared_ptr<GraphicsObject>& shape) {
-  if (!shape) return;
+#include "shapes/shape_visit.h"
+#include "tools/handle_helpers.h"
 
-  // line selection shows endpoint circle handles
-  auto line = std::dynamic_pointer_cast<Line>(shape);
-  if (line) {
-    QRectF box = shape->boundingBox();
-    QPen dashPen(Qt::cyan, 1, Qt::DashLine);
-    painter.setPen(dashPen);
-    painter.setBrush(Qt::NoBrush);
-    painter.drawRect(box);
-    painter.setPen(Qt::black);
-    painter.setBrush(Qt::lightGray);
-    double r = HANDLE_SIZE / 2.0;
-    painter.drawEllipse(QPointF(line->getX1(), line->getY1()), r, r);
-    painter.drawEllipse(QPointF(line->getX2(), line->getY2()), r, r);
-    return;
-  }
+namespace {
+// line selection shows endpoint circle handles
+void drawLineHandles(QPainter& painter, const QRectF& box, const Line& line) {
+  QPen dashPen(Qt::cyan, 1, Qt::DashLine);
+  painter.setPen(dashPen);
+  painter.setBrush(Qt::NoBrush);
+  painter.drawRect(box);
+  painter.setPen(Qt::black);
+  painter.setBrush(Qt::lightGray);
+  double r = HANDLE_SIZE / 2.0;
+  painter.drawEllipse(QPointF(line.getX1(), line.getY1()), r, r);
+  painter.drawEllipse(QPointF(line.getX2(), line.getY2()), r, r);
+}
 
-  // text selection only shows dashed bounds, no resize handles
-  // resizing of text is handled with font size changes, so handles would be
-  // confusing and not useful and also buggy
-  auto text = std::dynamic_pointer_cast<TextShape>(shape);
-  if (text) {
-    QRectF box = shape->boundingBox();
-    QColor hl(text->getFillColor().c_str());
-    if (!hl.isValid() || text->getFillColor() == "transparent" ||
-        text->getFillColor() == "none") {
-      hl = QColor(0, 120, 212, 40);
-    }
-    QColor borderCol = hl;
-    borderCol.setAlpha(std::min(255, borderCol.alpha() + 120));
-    QPen dashPen(borderCol, 1, Qt::DashLine);
-    painter.setPen(dashPen);
-    painter.setBrush(Qt::NoBrush);
-    painter.drawRect(box);
-    return;
-  }
+// text selection only shows dashed bounds, no resize handles
+// resizing of text is handled with font size changes, so handles would be
+// confusing and not useful and also buggy
+void drawTextBounds(QPainter& painter, const QRectF& box,
+                    const TextShape& text) {
+  QColor hl = text.getFill().none ? QColor(0, 120, 212, 40)
+                                  : text.getFill().toQColor();
+  QColor borderCol = hl;
+  borderCol.setAlpha(std::min(255, borderCol.alpha() + 120));
+  QPen dashPen(borderCol, 1, Qt::DashLine);
+  painter.setPen(dashPen);
+  painter.setBrush(Qt::NoBrush);
+  painter.drawRect(box);
+}
 
-  // default shape selection draws box and eight square handles
-  // handles are centered on corners and midpoints of bounding box edges
-  QRectF box = shape->boundingBox();
+// default shape selection draws box and eight square handles
+// handles are centered on corners and midpoints of bounding box edges
+void drawBoxHandles(QPainter& painter, const QRectF& box) {
   QPen borderPen(Qt::cyan, 1, Qt::DashLine);
   painter.setPen(borderPen);
   painter.setBrush(Qt::NoBrush);
@@ -71,3 +61,28 @@ void drawSelectionHandles(QPainter& painter,
                             HANDLE_SIZE));
   }
 }
+}  // namespace
+
+// draw selection handles for a shape, with different styles for lines and text
+void drawSelectionHandles(QPainter& painter,
+                          const std::shared_ptr<GraphicsObject>& shape) {
+  if (!shape) return;
+
+  QRectF box = shape->boundingBox();
+  visitShape(*shape, [&](auto& s) {
+    using T = std::decay_t<decltype(s)>;
+    if constexpr (std::is_same_v<T, Line>) {
+      drawLineHandles(painter, box, s);
+    } else if constexpr (std::is_same_v<T, TextShape>) {
+      drawTextBounds(painter, box, s);
+    } else if constexpr (std::is_same_v<T, Rectangle> ||
+                         std::is_same_v<T, RoundedRectangle> ||
+                         std::is_same_v<T, Circle> ||
+                         std::is_same_v<T, Hexagon> ||
+                         std::is_same_v<T, Freehand>) {
+      drawBoxHandles(painter, box);
+    } else {
+      static_assert(alwaysFalse<T>, "handles do not cover this shape");
+    }
+  });
+}
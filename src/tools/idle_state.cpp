@@ -5,6 +5,8 @@
 
 #include "gui/canvas.h"
 #include "shapes/freehand.h"
+#include "shapes/shape_cast.h"
+#include "shapes/shape_pool.h"
 #include "shapes/text_shape.h"
 #include "tools/handle_helpers.h"
 #include "tools/moving_state.h"
@@ -30,40 +32,34 @@ void IdleState::handleMousePress(Canvas* canvas, QMouseEvent* event) {
       QRectF box = selected->boundingBox();
       auto state = std::make_unique<ResizingState>(
           handle, box.left(), box.top(), box.right(), box.bottom());
-      auto fh = std::dynamic_pointer_cast<Freehand>(selected);
+      auto fh = shapeCast<Freehand>(selected);
       if (fh) state->snapshotFreehandPoints(fh->getPoints());
       canvas->setState(std::move(state));
-      canvas->update();
       return;
     }
   }
 
   // if not resizing, check if click is on a selected shape for moving
-  auto& shapes = canvas->getShapes();
-  for (auto it = shapes.rbegin(); it != shapes.rend(); ++it) {
-    if ((*it)->contains(click.x(), click.y())) {
-      canvas->setSelectedShape(*it);
-      canvas->endTextEditing();
-      canvas->setCursor(Qt::ClosedHandCursor);
-      canvas->setState(std::make_unique<MovingState>());
-      canvas->update();
-      return;
-    }
+  if (auto hit = canvas->shapeAt(click)) {
+    canvas->setSelectedShape(hit);
+    canvas->endTextEditing();
+    canvas->setCursor(Qt::ClosedHandCursor);
+    canvas->setState(std::make_unique<MovingState>());
+    return;
   }
 
   // text mode creates a draft text shape and starts inline editing
   if (canvas->getMode() == ShapeMode::TEXT) {
-    auto txt = std::make_shared<TextShape>(click.x(), click.y(), "");
+    auto txt = allocateShape<TextShape>(click.x(), click.y(), "");
     auto defaults = getCreationDefaults();
     applyDefaultShapeStyle(txt);
     txt->setFontFamily(defaults.fontFamily);
     txt->setFontSize(defaults.fontSize);
-    canvas->getShapes().push_back(txt);
+    canvas->addShape(txt);
     canvas->setSelectedShape(txt);
     canvas->setTextDraftShape(txt);
     canvas->beginTextEditing();
     canvas->setState(std::make_unique<IdleState>());
-    canvas->update();
     return;
   }
 
@@ -71,10 +67,7 @@ void IdleState::handleMousePress(Canvas* canvas, QMouseEvent* event) {
   canvas->setSelectedShape(nullptr);
 
   // select mode stops here no new shape creation
-  if (canvas->getMode() == ShapeMode::SELECT) {
-    canvas->update();
-    return;
-  }
+  if (canvas->getMode() == ShapeMode::SELECT) return;
 
   // shape modes create preview shape and go to creating state
   startShapeCreation(canvas, click);
@@ -91,14 +84,8 @@ void IdleState::handleMouseMove(Canvas* canvas, QMouseEvent* event) {
       return;
     }
   }
-  auto& shapes = canvas->getShapes();
-  for (auto it = shapes.rbegin(); it != shapes.rend(); ++it) {
-    if ((*it)->contains(pos.x(), pos.y())) {
-      canvas->setCursor(Qt::SizeAllCursor);
-      return;
-    }
-  }
-  canvas->setCursor(Qt::ArrowCursor);
+  canvas->setCursor(canvas->shapeAt(pos) ? Qt::SizeAllCursor
+                                         : Qt::ArrowCursor);
 }
 
 void IdleState::handleMouseRelease(Canvas*, QMouseEvent*) {}
@@ -8,6 +8,7 @@
 #include "shapes/line.h"
 #include "shapes/rectangle.h"
 #include "shapes/rounded_rectangle.h"
+#include "shapes/shape_pool.h"
 #include "tools/creating_state.h"
 #include "tools/shape_style_defaults.h"
 
@@ -17,40 +18,39 @@ void startShapeCreation(Canvas* canvas, QPointF click) {
   auto defaults = getCreationDefaults();
 
   if (canvas->getMode() == ShapeMode::CIRCLE) {
-    auto circle = std::make_shared<Circle>(click.x(), click.y(), 0);
+    auto circle = allocateShape<Circle>(click.x(), click.y(), 0);
     applyDefaultShapeStyle(circle);
     canvas->setPreviewShape(circle);
 
   } else if (canvas->getMode() == ShapeMode::HEXAGON) {
-    auto hex = std::make_shared<Hexagon>(click.x(), click.y(), 0, 0);
+    auto hex = allocateShape<Hexagon>(click.x(), click.y(), 0, 0);
     applyDefaultShapeStyle(hex);
     hex->setPointyTop(defaults.hexPointyTop);
     canvas->setPreviewShape(hex);
 
   } else if (canvas->getMode() == ShapeMode::LINE) {
     auto line =
-        std::make_shared<Line>(click.x(), click.y(), click.x(), click.y());
+        allocateShape<Line>(click.x(), click.y(), click.x(), click.y());
     applyDefaultLineStyle(line);
     canvas->setPreviewShape(line);
 
   } else if (canvas->getMode() == ShapeMode::ROUNDED_RECT) {
-    auto rr = std::make_shared<RoundedRectangle>(click.x(), click.y(), 0, 0);
+    auto rr = allocateShape<RoundedRectangle>(click.x(), click.y(), 0, 0);
     applyDefaultShapeStyle(rr);
     rr->setCornerRadius(defaults.cornerRadius);
     canvas->setPreviewShape(rr);
 
   } else if (canvas->getMode() == ShapeMode::FREEHAND) {
-    auto fh = std::make_shared<Freehand>();
+    auto fh = allocateShape<Freehand>();
     applyDefaultLineStyle(fh);
     fh->addPoint(click.x(), click.y());
     canvas->setPreviewShape(fh);
 
   } else {
-    auto rect = std::make_shared<Rectangle>(click.x(), click.y(), 0, 0);
+    auto rect = allocateShape<Rectangle>(click.x(), click.y(), 0, 0);
     applyDefaultShapeStyle(rect);
     canvas->setPreviewShape(rect);
   }
 
   canvas->setState(std::make_unique<CreatingState>());
-  canvas->update();
 }
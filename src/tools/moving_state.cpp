@@ -17,18 +17,20 @@ void MovingState::handleMouseMove(Canvas* canvas, QMouseEvent* event) {
   auto& selected = canvas->getSelectedShape();
   if (!selected) return;
   canvas->setCursor(Qt::ClosedHandCursor);
+  if (!canvas->hasStaticLayer()) canvas->beginStaticLayer(selected);
 
   QPointF current = event->position();
   QPointF last = canvas->getLastMousePos();
   double dx = current.x() - last.x();
   double dy = current.y() - last.y();
 
+  canvas->aboutToChange(selected);
   selected->moveBy(dx, dy);
+  canvas->shapeChanged(selected);
 
   totalDx += dx;
   totalDy += dy;
   canvas->setLastMousePos(current);
-  canvas->update();
 }
 
 // on release store one move command with total drag delta then return to idle
@@ -37,7 +39,8 @@ void MovingState::handleMouseRelease(Canvas* canvas, QMouseEvent* event) {
   auto& sel = canvas->getSelectedShape();
   if (sel && (totalDx != 0 || totalDy != 0))
     canvas->pushCommand(std::make_unique<MoveCommand>(sel, totalDx, totalDy));
+  else
+    canvas->settleEdits();
   canvas->setCursor(sel ? Qt::SizeAllCursor : Qt::ArrowCursor);
   canvas->setState(std::make_unique<IdleState>());
-  canvas->update();
 }
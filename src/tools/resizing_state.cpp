@@ -7,6 +7,7 @@
 
 #include "gui/canvas.h"
 #include "shapes/line.h"
+#include "shapes/shape_cast.h"
 #include "tools/command.h"
 #include "tools/idle_state.h"
 
@@ -21,8 +22,8 @@ ResizingState::ResizingState(HandleType handle, double left, double top,
       oldBox(left, top, right - left, bottom - top) {}
 
 // save freehand points before resize so shape can be remapped proportionally
-void ResizingState::snapshotFreehandPoints(const std::vector<QPointF>& pts) {
-  origFreehandPts = pts;
+void ResizingState::snapshotFreehandPoints(const PointBuffer& pts) {
+  origFreehandPts.assign(pts.begin(), pts.end());
   if (!pts.empty()) {
     double minX = pts[0].x(), maxX = minX;
     double minY = pts[0].y(), maxY = minY;
@@ -46,16 +47,18 @@ void ResizingState::handleMouseMove(Canvas* canvas, QMouseEvent* event) {
   if (!selected) return;
 
   QPointF pos = event->position();
+  if (!canvas->hasStaticLayer()) canvas->beginStaticLayer(selected);
 
   // line uses endpoint handles not box resize
-  auto line = std::dynamic_pointer_cast<Line>(selected);
+  auto line = shapeCast<Line>(selected);
   if (line) {
+    canvas->aboutToChange(selected);
     if (activeHandle == HandleType::LINE_START)
       line->setEndpoints(pos.x(), pos.y(), line->getX2(), line->getY2());
     else if (activeHandle == HandleType::LINE_END)
       line->setEndpoints(line->getX1(), line->getY1(), pos.x(), pos.y());
+    canvas->shapeChanged(selected);
     canvas->setLastMousePos(pos);
-    canvas->update();
     return;
   }
 
@@ -70,7 +73,8 @@ void ResizingState::handleMouseRelease(Canvas* canvas, QMouseEvent* event) {
     QRectF newBox = sel->boundingBox();
     if (newBox != oldBox)
       canvas->pushCommand(std::make_unique<ResizeCommand>(sel, oldBox, newBox));
+    else
+      canvas->settleEdits();
   }
   canvas->setState(std::make_unique<IdleState>());
-  canvas->update();
 }
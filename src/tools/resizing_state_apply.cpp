@@ -3,13 +3,11 @@
 
 #include <algorithm>
 #include <cmath>
+#include <type_traits>
 
 #include "gui/canvas.h"
-#include "shapes/circle.h"
-#include "shapes/freehand.h"
-#include "shapes/hexagon.h"
-#include "shapes/rectangle.h"
-#include "shapes/rounded_rectangle.h"
+#include "shapes/shape_pool.h"
+#include "shapes/shape_visit.h"
 #include "tools/resizing_state.h"
 
 // apply active resize handle movement to selected shape geometry
@@ -58,52 +56,46 @@ void ResizingState::applyResize(Canvas* canvas, QPointF pos) {
   double newW = std::abs(right - left);
   double newH = std::abs(bottom - top);
 
-  // apply resized box to each supported shape type
-  auto rect = std::dynamic_pointer_cast<Rectangle>(selected);
-  if (rect) {
-    QRectF box = selected->boundingBox();
-    rect->moveBy(newX - box.x(), newY - box.y());
-    rect->setGeometry(newW, newH);
-  }
-
-  // rounded rect is resized by moving top-left corner and setting new geometry
-  auto rr = std::dynamic_pointer_cast<RoundedRectangle>(selected);
-  if (rr) {
-    QRectF box = selected->boundingBox();
-    rr->moveBy(newX - box.x(), newY - box.y());
-    rr->setGeometry(newW, newH);
-  }
-
-  // circle is resized by moving center and setting new radii
-  auto circle = std::dynamic_pointer_cast<Circle>(selected);
-  if (circle) {
-    circle->setCenter(newX + newW / 2.0, newY + newH / 2.0);
-    circle->setRadii(newW / 2.0, newH / 2.0);
-  }
-
-  // keep hex orientation and only update center and radii
-  auto hex = std::dynamic_pointer_cast<Hexagon>(selected);
-  if (hex) {
-    hex->setCenter(newX + newW / 2.0, newY + newH / 2.0);
-    hex->setRadii(newW / 2.0, newH / 2.0);
-  }
-
-  // freehand is remapped by relative point coordinates
-  auto fh = std::dynamic_pointer_cast<Freehand>(selected);
-  if (fh && !origFreehandPts.empty() && origFreehandBox.width() > 0.5 &&
-      origFreehandBox.height() > 0.5) {
-    auto& pts = const_cast<std::vector<QPointF>&>(fh->getPoints());
-    for (size_t i = 0; i < pts.size() && i < origFreehandPts.size(); i++) {
-      double tx = (origFreehandPts[i].x() - origFreehandBox.x()) /
-                  origFreehandBox.width();
-      double ty = (origFreehandPts[i].y() - origFreehandBox.y()) /
-                  origFreehandBox.height();
-      pts[i].setX(left + tx * (right - left));
-      pts[i].setY(top + ty * (bottom - top));
+  // apply resized box by shape class, switch dispatched on the type tag
+  canvas->aboutToChange(selected);
+  visitShape(*selected, [&](auto& shape) {
+    using T = std::decay_t<decltype(shape)>;
+    if constexpr (std::is_same_v<T, Rectangle> ||
+                  std::is_same_v<T, RoundedRectangle>) {
+      // box shapes move their top-left corner and take the new size
+      QRectF box = shape.boundingBox();
+      shape.moveBy(newX - box.x(), newY - box.y());
+      shape.setGeometry(newW, newH);
+    } else if constexpr (std::is_same_v<T, Circle> ||
+                         std::is_same_v<T, Hexagon>) {
+      // keep ellipse and hex orientation, only update center and radii
+      shape.setCenter(newX + newW / 2.0, newY + newH / 2.0);
+      shape.setRadii(newW / 2.0, newH / 2.0);
+    } else if constexpr (std::is_same_v<T, Freehand>) {
+      // freehand is remapped by relative point coordinates
+      if (origFreehandPts.empty() || origFreehandBox.width() <= 0.5 ||
+          origFreehandBox.height() <= 0.5)
+        return;
+      PointBuffer pts(shapeMemory());
+      pts.reserve(origFreehandPts.size());
+      for (const QPointF& p : origFreehandPts) {
+        double tx = (p.x() - origFreehandBox.x()) / origFreehandBox.width();
+        double ty = (p.y() - origFreehandBox.y()) / origFreehandBox.height();
+        pts.emplace_back(left + tx * (right - left),
+                         top + ty * (bottom - top));
+      }
+      shape.setPoints(std::move(pts));
+    } else if constexpr (std::is_same_v<T, Line> ||
+                         std::is_same_v<T, TextShape>) {
+      // lines follow their endpoint handles and text keeps its font size,
+      // neither takes a resized box
+    } else {
+      static_assert(alwaysFalse<T>, "resizing does not handle this shape");
     }
-  }
+  });
 
-  // store last mouse position for state bookkeeping and repaint
+  // store last mouse position for state bookkeeping and repaint the old and
+  // new area of the shape
+  canvas->shapeChanged(selected);
   canvas->setLastMousePos(pos);
-  canvas->update();
 }
@@ -6,6 +6,7 @@
 #include "gui/canvas.h"
 #include "shapes/hexagon.h"
 #include "shapes/rounded_rectangle.h"
+#include "shapes/shape_cast.h"
 #include "shapes/text_shape.h"
 
 // compare full property snapshots to detect changes
@@ -37,29 +38,30 @@ ShapePropertyCommand::ShapePropertyCommand(
 void ShapePropertyCommand::applyState(const ShapePropertyState& state,
                                       Canvas* canvas) {
   if (!shape) return;
+  canvas->aboutToChange(shape);
   shape->setFillColor(state.fillColor);
   shape->setStrokeColor(state.strokeColor);
   shape->setStrokeWidth(state.strokeWidth);
 
   if (state.hasCornerRadius) {
-    if (auto rr = std::dynamic_pointer_cast<RoundedRectangle>(shape))
+    if (auto rr = shapeCast<RoundedRectangle>(shape))
       rr->setCornerRadius(state.cornerRadius);
   }
   if (state.hasPointyTop) {
-    if (auto hex = std::dynamic_pointer_cast<Hexagon>(shape))
+    if (auto hex = shapeCast<Hexagon>(shape))
       hex->setPointyTop(state.pointyTop);
   }
   if (state.hasTextStyle) {
-    if (auto text = std::dynamic_pointer_cast<TextShape>(shape)) {
+    if (auto text = shapeCast<TextShape>(shape)) {
       text->setFontFamily(state.fontFamily);
       text->setFontSize(state.fontSize);
     }
   }
   if (state.hasTextContent) {
-    if (auto text = std::dynamic_pointer_cast<TextShape>(shape))
+    if (auto text = shapeCast<TextShape>(shape))
       text->setText(state.textContent);
   }
-  canvas->update();
+  canvas->shapeChanged(shape);
 }
 
 // undo replays before snapshot
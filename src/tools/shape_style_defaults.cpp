@@ -7,8 +7,9 @@
 
 namespace {
 // global defaults used by properties panel and shape creation flow
-CreationDefaults gCreationDefaults{"#80ffffff", "#ff000000", "transparent", 1.0,
-                                   10.0,        false,       "Arial",       16};
+CreationDefaults gCreationDefaults{
+    "#80ffffff", "#ff000000", "transparent", 1.0, 10.0, false, "Arial", 16,
+    0.5,         false};
 }  // namespace
 
 // return current defaults snapshot
@@ -21,6 +22,8 @@ void setCreationDefaults(const CreationDefaults& defaults) {
   if (gCreationDefaults.cornerRadius < 0.0)
     gCreationDefaults.cornerRadius = 0.0;
   if (gCreationDefaults.fontSize < 1) gCreationDefaults.fontSize = 1;
+  if (gCreationDefaults.simplifyTolerance < 0.0)
+    gCreationDefaults.simplifyTolerance = 0.0;
 }
 
 // convenience getters used by panel initialization
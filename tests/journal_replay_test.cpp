@@ -0,0 +1,99 @@
+// journal_replay_test.cpp
+// recovery after a save replays onto the saved file with the live z keys
+
+#include <QDir>
+#include <QStandardPaths>
+#include <cstdio>
+#include <fstream>
+
+#include "gui/document_journal.h"
+#include "shapes/rectangle.h"
+#include "shapes/svg_document.h"
+
+namespace {
+
+using ShapePtr = std::shared_ptr<GraphicsObject>;
+
+ShapePtr rect(double x) { return std::make_shared<Rectangle>(x, 0, 10, 10); }
+
+void writeFile(const std::string& path, const std::vector<ShapePtr>& shapes) {
+  SvgWriter out;
+  writeSvgDocument(out, 800, 600, shapes);
+  std::ofstream(path, std::ios::binary) << out.data();
+}
+
+void addShape(ShapeStore& shapes, DocumentJournal& journal,
+              const ShapePtr& shape) {
+  shapes.insertTop(shape);
+  journal.shapeAdded(shape, shapes.zOf(shape.get()));
+  journal.commit(shapes);
+}
+
+void removeShape(ShapeStore& shapes, DocumentJournal& journal,
+                 const ShapePtr& shape) {
+  journal.shapeRemoved(shapes.remove(shape.get()));
+  journal.commit(shapes);
+}
+
+// replay the running journal and compare the x of each shape in z order
+bool recovers(const DocumentJournal& journal, const std::string& base,
+              const std::vector<double>& xs, const char* name) {
+  std::string basePath;
+  ShapeStore recovered;
+  bool ok = DocumentJournal::replay(journal.path(), basePath, recovered) &&
+            basePath == base && recovered.size() == xs.size();
+  size_t i = 0;
+  for (auto it = recovered.begin(); ok && it != recovered.end(); ++it)
+    ok = (*it)->boundingBox().x() == xs[i++];
+  std::printf("%s: %s\n", name, ok ? "ok" : "FAIL");
+  return ok;
+}
+
+// load A B C, delete B, save, delete C: only A comes back
+bool deleteAfterSave(const std::string& base) {
+  ShapePtr a = rect(0), b = rect(100), c = rect(200);
+  writeFile(base, {a, b, c});
+  ShapeStore shapes;
+  shapes.assign({a, b, c});
+  DocumentJournal journal;
+  journal.start(base);
+  removeShape(shapes, journal, b);
+  journal.markSnapshot(shapes);
+  writeFile(base, {a, c});
+  journal.snapshotSaved(base);
+  removeShape(shapes, journal, c);
+  bool ok = recovers(journal, base, {0}, "delete after save");
+  journal.discard();
+  return ok;
+}
+
+// the save replaced the file but the journal never restarted from it,
+// records before the snapshot must not apply a second time
+bool crashBeforeRestart(const std::string& base) {
+  ShapePtr a = rect(0), b = rect(100), c = rect(200), d = rect(300);
+  writeFile(base, {a, b, c});
+  ShapeStore shapes;
+  shapes.assign({a, b, c});
+  DocumentJournal journal;
+  journal.start(base);
+  removeShape(shapes, journal, b);
+  addShape(shapes, journal, d);
+  journal.markSnapshot(shapes);
+  writeFile(base, {a, c, d});
+  removeShape(shapes, journal, a);
+  bool ok = recovers(journal, base, {200, 300}, "crash before restart");
+  journal.discard();
+  return ok;
+}
+
+}  // namespace
+
+int main() {
+  QStandardPaths::setTestModeEnabled(true);
+  std::string base =
+      QDir::tempPath().toStdString() + "/journal_replay_test.svg";
+  bool ok = deleteAfterSave(base);
+  ok = crashBeforeRestart(base) && ok;
+  std::remove(base.c_str());
+  return ok ? 0 : 1;
+}